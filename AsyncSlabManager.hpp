@@ -0,0 +1,331 @@
+#pragma once
+
+#include "SlabManager.hpp"
+
+#if defined(__cpp_impl_coroutine) && defined(__has_include)
+#if __has_include(<coroutine>)
+#include <coroutine>
+#define GEN_SLAB_HAS_COROUTINES 1
+#endif
+#endif
+
+#if defined(GEN_SLAB_HAS_COROUTINES)
+
+namespace gen {
+
+    /// <summary> Bounded slab manager for C++20 coroutines. When all capacity()
+    ///        slots are filled, co_await async_acquire() suspends the calling
+    ///        coroutine instead of blocking a thread; give_back() then hands
+    ///        the released index straight to the longest waiting coroutine
+    ///        (the slot stays filled, the empty list is not touched) and
+    ///        resumes it before returning. The waiter queue is intrusive - each
+    ///        waiter is the awaiter object in the suspended coroutine's frame -
+    ///        so suspending does not allocate. Not thread-safe: meant for a
+    ///        single-threaded event loop. Manager is the underlying
+    ///        BasicSlabManager instantiation. Requires C++20. </summary>
+    ///
+    template <class Manager = SlabManager>
+    class AsyncSlabManager {
+
+        public:
+
+            typedef typename Manager::Index Index;
+
+            class AcquireAwaiter;
+
+        private:
+
+            Manager central;
+
+            size_t cap;
+
+            // FIFO of suspended waiters, linked through the awaiters:
+            AcquireAwaiter * wait_head;
+            AcquireAwaiter * wait_tail;
+
+            size_t wait_cnt;
+
+            void enqueue(AcquireAwaiter * w);
+            void  unlink(AcquireAwaiter * w);
+
+            void hand_over(Index ind);
+
+        public:
+
+            AsyncSlabManager(const AsyncSlabManager & other) = delete;
+            AsyncSlabManager & operator=(const AsyncSlabManager & other) = delete;
+
+            /// <summary> Construct with room for at most capacity filled slots (min 1),
+            ///        n of them reserved up front. Must not be destroyed while
+            ///        coroutines are waiting on it. </summary>
+            ///
+            explicit AsyncSlabManager(size_t capacity, size_t n = 1);
+
+            /// <summary> Returns the maximum number of filled slots. </summary>
+            ///
+            size_t capacity() const;
+
+            /// <summary> Returns an awaitable that yields a slot index, suspending the
+            ///        awaiting coroutine while all capacity() slots are filled. </summary>
+            ///
+            AcquireAwaiter async_acquire();
+
+            /// <summary> Acquire a slot into out if one is free, without suspending.
+            ///        Returns false if all capacity() slots are filled. </summary>
+            ///
+            bool try_acquire(Index & out);
+
+            /// <summary> Give a slot back. If coroutines are waiting, the slot is handed
+            ///        to the first of them, which is resumed before this returns. </summary>
+            ///
+            void give_back(Index ind);
+
+            /// <summary> give_back() that returns a status code instead of throwing. </summary>
+            ///
+            SlabStatus try_give_back(Index ind);
+
+            /// <summary> Returns the number of filled slots (handed-over slots included). </summary>
+            ///
+            size_t filled_count() const;
+
+            /// <summary> Returns the number of suspended waiters. </summary>
+            ///
+            size_t waiting() const;
+
+        };
+
+    /// <summary> Awaitable returned by AsyncSlabManager::async_acquire(). It lives
+    ///        in the awaiting coroutine's frame and doubles as the waiter
+    ///        queue node; destroying a suspended coroutine removes it from
+    ///        the queue. </summary>
+    ///
+    template <class Manager>
+    class AsyncSlabManager<Manager>::AcquireAwaiter {
+
+        public:
+
+            AcquireAwaiter(const AcquireAwaiter & other) = delete;
+            AcquireAwaiter & operator=(const AcquireAwaiter & other) = delete;
+
+            ~AcquireAwaiter();
+
+            bool await_ready();
+
+            void await_suspend(std::coroutine_handle<> h);
+
+            Index await_resume() const;
+
+        private:
+
+            friend class AsyncSlabManager;
+
+            explicit AcquireAwaiter(AsyncSlabManager & owner);
+
+            AsyncSlabManager * owner;
+
+            std::coroutine_handle<> waiter;
+
+            AcquireAwaiter * prev;
+            AcquireAwaiter * next;
+
+            bool queued;
+
+            Index ind;
+
+        };
+
+    // *** Implementation below: *** //
+
+    template <class Manager>
+    inline
+    AsyncSlabManager<Manager>::AsyncSlabManager(size_t capacity, size_t n)
+        : central((n < capacity) ? n : capacity)
+        , cap((capacity > 0) ? capacity : 1u)
+        , wait_head(nullptr)
+        , wait_tail(nullptr)
+        , wait_cnt(0) {
+
+        central.set_size_limit(cap);
+
+        }
+
+    template <class Manager>
+    inline
+    size_t AsyncSlabManager<Manager>::capacity() const {
+
+        return cap;
+
+        }
+
+    template <class Manager>
+    inline
+    void AsyncSlabManager<Manager>::enqueue(AcquireAwaiter * w) {
+
+        w->prev = wait_tail;
+        w->next = nullptr;
+
+        if (wait_tail != nullptr)
+            wait_tail->next = w;
+        else
+            wait_head = w;
+
+        wait_tail = w;
+
+        w->queued = true;
+
+        wait_cnt += 1;
+
+        }
+
+    template <class Manager>
+    inline
+    void AsyncSlabManager<Manager>::unlink(AcquireAwaiter * w) {
+
+        if (w->next != nullptr)
+            w->next->prev = w->prev;
+        else
+            wait_tail = w->prev;
+
+        if (w->prev != nullptr)
+            w->prev->next = w->next;
+        else
+            wait_head = w->next;
+
+        w->queued = false;
+
+        wait_cnt -= 1;
+
+        }
+
+    template <class Manager>
+    inline
+    typename AsyncSlabManager<Manager>::AcquireAwaiter AsyncSlabManager<Manager>::async_acquire() {
+
+        return AcquireAwaiter(*this);
+
+        }
+
+    template <class Manager>
+    inline
+    bool AsyncSlabManager<Manager>::try_acquire(Index & out) {
+
+        // Queued waiters go first, even if a slot is free meanwhile:
+        if (wait_head != nullptr || central.filled_count() >= cap) return false;
+
+        out = central.acquire();
+
+        return true;
+
+        }
+
+    template <class Manager>
+    inline
+    void AsyncSlabManager<Manager>::give_back(Index ind) {
+
+        if (wait_head == nullptr) { central.give_back(ind); return; }
+
+        if (central.is_slot_empty(ind)) GEN_SLAB_THROW(std::logic_error("AsyncSlabManager::give_back - Element not acquired!"));
+
+        hand_over(ind);
+
+        }
+
+    template <class Manager>
+    inline
+    SlabStatus AsyncSlabManager<Manager>::try_give_back(Index ind) {
+
+        if (wait_head == nullptr) return central.try_give_back(ind);
+
+        if (ind >= central.size())                return SLAB_OUT_OF_BOUNDS;
+        if (central.is_slot_empty_unchecked(ind)) return SLAB_NOT_ACQUIRED;
+
+        hand_over(ind);
+
+        return SLAB_OK;
+
+        }
+
+    template <class Manager>
+    inline
+    void AsyncSlabManager<Manager>::hand_over(Index ind) {
+
+        // Hand the still filled slot over to the first waiter:
+        AcquireAwaiter * w = wait_head;
+
+        unlink(w);
+
+        w->ind = ind;
+
+        w->waiter.resume();
+
+        }
+
+    template <class Manager>
+    inline
+    size_t AsyncSlabManager<Manager>::filled_count() const {
+
+        return central.filled_count();
+
+        }
+
+    template <class Manager>
+    inline
+    size_t AsyncSlabManager<Manager>::waiting() const {
+
+        return wait_cnt;
+
+        }
+
+    // AcquireAwaiter:
+
+    template <class Manager>
+    inline
+    AsyncSlabManager<Manager>::AcquireAwaiter::AcquireAwaiter(AsyncSlabManager & owner)
+        : owner(&owner)
+        , prev(nullptr)
+        , next(nullptr)
+        , queued(false)
+        , ind(0) {
+
+        }
+
+    template <class Manager>
+    inline
+    AsyncSlabManager<Manager>::AcquireAwaiter::~AcquireAwaiter() {
+
+        // The coroutine was destroyed while suspended:
+        if (queued) owner->unlink(this);
+
+        }
+
+    template <class Manager>
+    inline
+    bool AsyncSlabManager<Manager>::AcquireAwaiter::await_ready() {
+
+        return owner->try_acquire(ind);
+
+        }
+
+    template <class Manager>
+    inline
+    void AsyncSlabManager<Manager>::AcquireAwaiter::await_suspend(std::coroutine_handle<> h) {
+
+        waiter = h;
+
+        owner->enqueue(this);
+
+        }
+
+    template <class Manager>
+    inline
+    typename AsyncSlabManager<Manager>::Index AsyncSlabManager<Manager>::AcquireAwaiter::await_resume() const {
+
+        return ind;
+
+        }
+
+    // *** Implementation End *** //
+
+    }
+
+#endif
\ No newline at end of file
@@ -0,0 +1,256 @@
+#pragma once
+
+#include "SlabManager.hpp"
+
+#include <mutex>
+#include <chrono>
+#include <condition_variable>
+
+namespace gen {
+
+    /// <summary> Thread-safe slab manager with a hard cap on the number of filled
+    ///        slots, for use as admission control. try_acquire() fails when
+    ///        the cap is reached, and acquire() blocks until a give_back()
+    ///        frees a slot. Rejections and time spent waiting are counted.
+    ///        Manager is the underlying BasicSlabManager instantiation; it
+    ///        is guarded by a mutex and never grows past the cap. </summary>
+    ///
+    template <class Manager = SlabManager>
+    class BoundedSlabManager {
+
+        public:
+
+            typedef typename Manager::Index Index;
+
+        private:
+
+            mutable std::mutex mtx;
+
+            std::condition_variable freed;
+
+            Manager central;
+
+            size_t cap;
+
+            // Statistics (guarded by mtx):
+            size_t reject_cnt;
+            size_t wait_cnt;
+
+            std::chrono::nanoseconds wait_ns;
+
+        public:
+
+            BoundedSlabManager(const BoundedSlabManager & other) = delete;
+            BoundedSlabManager & operator=(const BoundedSlabManager & other) = delete;
+
+            /// <summary> Construct with room for at most capacity filled slots (min 1),
+            ///        n of them reserved up front. </summary>
+            ///
+            explicit BoundedSlabManager(size_t capacity, size_t n = 1);
+
+            /// <summary> Returns the maximum number of filled slots. </summary>
+            ///
+            size_t capacity() const;
+
+            /// <summary> Acquire a slot, blocking while all capacity() slots are
+            ///        filled. </summary>
+            ///
+            Index acquire();
+
+            /// <summary> Acquire a slot into out if one is free. Returns false (and
+            ///        counts a rejection) if all capacity() slots are filled. </summary>
+            ///
+            bool try_acquire(Index & out);
+
+            /// <summary> Acquire a slot into out, waiting at most timeout for one to be
+            ///        freed. Returns false (and counts a rejection) on timeout. </summary>
+            ///
+            template <class Rep, class Period>
+            bool try_acquire_for(const std::chrono::duration<Rep, Period> & timeout, Index & out);
+
+            /// <summary> Give a slot back and wake one blocked acquire(). </summary>
+            ///
+            void give_back(Index ind);
+
+            /// <summary> give_back() that returns a status code instead of throwing. </summary>
+            ///
+            SlabStatus try_give_back(Index ind);
+
+            /// <summary> Returns the number of filled slots. </summary>
+            ///
+            size_t filled_count() const;
+
+            /// <summary> Returns the number of failed try_acquire() / try_acquire_for() calls. </summary>
+            ///
+            size_t rejections() const;
+
+            /// <summary> Returns the number of acquisitions that had to wait. </summary>
+            ///
+            size_t waits() const;
+
+            /// <summary> Returns the total time spent waiting for a slot, including
+            ///        waits that timed out. </summary>
+            ///
+            std::chrono::nanoseconds wait_time() const;
+
+        };
+
+    // *** Implementation below: *** //
+
+    template <class Manager>
+    inline
+    BoundedSlabManager<Manager>::BoundedSlabManager(size_t capacity, size_t n)
+        : central((n < capacity) ? n : capacity)
+        , cap((capacity > 0) ? capacity : 1u)
+        , reject_cnt(0)
+        , wait_cnt(0)
+        , wait_ns(0) {
+
+        central.set_size_limit(cap);
+
+        }
+
+    template <class Manager>
+    inline
+    size_t BoundedSlabManager<Manager>::capacity() const {
+
+        return cap;
+
+        }
+
+    template <class Manager>
+    inline
+    typename BoundedSlabManager<Manager>::Index BoundedSlabManager<Manager>::acquire() {
+
+        std::unique_lock<std::mutex> lock(mtx);
+
+        if (central.filled_count() >= cap) {
+
+            auto start = std::chrono::steady_clock::now();
+
+            freed.wait(lock, [this] { return central.filled_count() < cap; });
+
+            wait_cnt += 1;
+            wait_ns  += std::chrono::duration_cast<std::chrono::nanoseconds>(std::chrono::steady_clock::now() - start);
+
+            }
+
+        return central.acquire();
+
+        }
+
+    template <class Manager>
+    inline
+    bool BoundedSlabManager<Manager>::try_acquire(Index & out) {
+
+        std::lock_guard<std::mutex> lock(mtx);
+
+        if (central.filled_count() >= cap) { reject_cnt += 1; return false; }
+
+        out = central.acquire();
+
+        return true;
+
+        }
+
+    template <class Manager>
+    template <class Rep, class Period>
+    inline
+    bool BoundedSlabManager<Manager>::try_acquire_for(const std::chrono::duration<Rep, Period> & timeout, Index & out) {
+
+        std::unique_lock<std::mutex> lock(mtx);
+
+        if (central.filled_count() >= cap) {
+
+            auto start = std::chrono::steady_clock::now();
+
+            bool ok = freed.wait_for(lock, timeout, [this] { return central.filled_count() < cap; });
+
+            wait_cnt += 1;
+            wait_ns  += std::chrono::duration_cast<std::chrono::nanoseconds>(std::chrono::steady_clock::now() - start);
+
+            if (!ok) { reject_cnt += 1; return false; }
+
+            }
+
+        out = central.acquire();
+
+        return true;
+
+        }
+
+    template <class Manager>
+    inline
+    void BoundedSlabManager<Manager>::give_back(Index ind) {
+
+        {
+            std::lock_guard<std::mutex> lock(mtx);
+
+            central.give_back(ind);
+        }
+
+        freed.notify_one();
+
+        }
+
+    template <class Manager>
+    inline
+    SlabStatus BoundedSlabManager<Manager>::try_give_back(Index ind) {
+
+        SlabStatus st;
+
+        {
+            std::lock_guard<std::mutex> lock(mtx);
+
+            st = central.try_give_back(ind);
+        }
+
+        if (st == SLAB_OK) freed.notify_one();
+
+        return st;
+
+        }
+
+    template <class Manager>
+    inline
+    size_t BoundedSlabManager<Manager>::filled_count() const {
+
+        std::lock_guard<std::mutex> lock(mtx);
+
+        return central.filled_count();
+
+        }
+
+    template <class Manager>
+    inline
+    size_t BoundedSlabManager<Manager>::rejections() const {
+
+        std::lock_guard<std::mutex> lock(mtx);
+
+        return reject_cnt;
+
+        }
+
+    template <class Manager>
+    inline
+    size_t BoundedSlabManager<Manager>::waits() const {
+
+        std::lock_guard<std::mutex> lock(mtx);
+
+        return wait_cnt;
+
+        }
+
+    template <class Manager>
+    inline
+    std::chrono::nanoseconds BoundedSlabManager<Manager>::wait_time() const {
+
+        std::lock_guard<std::mutex> lock(mtx);
+
+        return wait_ns;
+
+        }
+
+    // *** Implementation End *** //
+
+    }
\ No newline at end of file
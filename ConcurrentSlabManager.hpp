@@ -0,0 +1,397 @@
+#pragma once
+
+#include "SlabManager.hpp"
+
+#include <atomic>
+#include <cstdint>
+#include <stdexcept>
+
+namespace gen {
+
+    /// <summary> Thread-safe slab manager with lock-free acquire() and give_back().
+    ///        Empty slots form a Treiber stack whose head packs a slot index
+    ///        with a modification tag, so a pop racing with a pop and re-push
+    ///        of the same slot (ABA) fails its CAS instead of corrupting the
+    ///        stack. Slots are stored in chunks of doubling size that are never
+    ///        moved or freed while the manager lives, so growth does not stop
+    ///        concurrent readers. Indices are 32-bit. </summary>
+    ///
+    class ConcurrentSlabManager {
+
+        public:
+
+            typedef std::uint32_t Index;
+
+        private:
+
+            static const Index NULL_INDEX = Index(-1);
+
+            typedef std::uint64_t Word;
+
+            static const size_t WORD_BITS = 64;
+
+            // Chunk c holds (BASE << c) slots; 21 chunks cover the 32-bit range:
+            static const unsigned BASE_SHIFT = 12;
+            static const size_t   BASE       = size_t(1) << BASE_SHIFT;
+            static const unsigned MAX_CHUNKS = 32;
+
+            struct Chunk {
+
+                std::atomic<Index> * next_arr; // Links of the empty stack
+                std::atomic<Word>  * occ_arr;  // Occupancy bits (bit set = slot filled)
+
+                };
+
+            std::atomic<Chunk *> chunk_arr[MAX_CHUNKS];
+
+            std::atomic<std::uint64_t> empty_head; // (tag << 32) | index
+            std::atomic<size_t>        bump;       // Slots handed out at least once
+
+            static std::uint64_t pack(Index ind, std::uint32_t tag);
+
+            static Index         index_of(std::uint64_t head);
+            static std::uint32_t   tag_of(std::uint64_t head);
+
+            static void locate(size_t ind, unsigned & chunk, size_t & offset);
+
+            Chunk * chunk_for(size_t ind, size_t & offset) const;
+            Chunk * make_chunk(unsigned c);
+
+        public:
+
+            ConcurrentSlabManager(const ConcurrentSlabManager & other) = delete;
+            ConcurrentSlabManager & operator=(const ConcurrentSlabManager & other) = delete;
+
+            /// <summary> Construct an empty manager. </summary>
+            ///
+            ConcurrentSlabManager();
+
+            /// <summary> Construct with storage for n slots preallocated. </summary>
+            ///
+            ConcurrentSlabManager(size_t n);
+
+            ~ConcurrentSlabManager();
+
+            /// <summary> Acquire a slot (it will be marked as not empty). Lock-free.
+            ///        Throws std::length_error when the 32-bit index range is
+            ///        exhausted. </summary>
+            ///
+            Index acquire();
+
+            /// <summary> Give a previously acquired slot back. Lock-free. Throws
+            ///        std::logic_error if the slot is empty, so a slot can never
+            ///        end up on the empty stack twice. </summary>
+            ///
+            void give_back(Index ind);
+
+            /// <summary> give_back() that returns SLAB_OUT_OF_BOUNDS or SLAB_NOT_ACQUIRED
+            ///        instead of throwing. Lock-free. </summary>
+            ///
+            SlabStatus try_give_back(Index ind) noexcept;
+
+            /// <summary> Checks if the slot with the given index is empty. </summary>
+            ///
+            bool is_slot_empty(Index ind) const;
+
+            /// <summary> Returns the number of slots handed out at least once. </summary>
+            ///
+            size_t size() const;
+
+            /// <summary> Returns the number of filled slots. Scans the occupancy
+            ///        bitmap, so it is O(size) and only a snapshot under
+            ///        concurrent modification. </summary>
+            ///
+            size_t filled_count() const;
+
+            /// <summary> Preallocate storage for at least n slots. </summary>
+            ///
+            void reserve(size_t n);
+
+            /// <summary> Mark all slots as empty. Not thread-safe - must not run
+            ///        concurrently with any other method. </summary>
+            ///
+            void clear();
+
+        };
+
+    // *** Implementation below: *** //
+
+    inline
+    ConcurrentSlabManager::ConcurrentSlabManager()
+        : empty_head(pack(NULL_INDEX, 0))
+        , bump(0) {
+
+        for (unsigned c = 0; c < MAX_CHUNKS; c += 1) chunk_arr[c].store(nullptr, std::memory_order_relaxed);
+
+        }
+
+    inline
+    ConcurrentSlabManager::ConcurrentSlabManager(size_t n)
+        : ConcurrentSlabManager() {
+
+        reserve(n);
+
+        }
+
+    inline
+    ConcurrentSlabManager::~ConcurrentSlabManager() {
+
+        for (unsigned c = 0; c < MAX_CHUNKS; c += 1) {
+
+            Chunk * chunk = chunk_arr[c].load(std::memory_order_relaxed);
+
+            if (chunk == nullptr) continue;
+
+            delete[] chunk->next_arr;
+            delete[] chunk->occ_arr;
+            delete chunk;
+
+            }
+
+        }
+
+    inline
+    std::uint64_t ConcurrentSlabManager::pack(Index ind, std::uint32_t tag) {
+
+        return (std::uint64_t(tag) << 32) | std::uint64_t(ind);
+
+        }
+
+    inline
+    ConcurrentSlabManager::Index ConcurrentSlabManager::index_of(std::uint64_t head) {
+
+        return Index(head & 0xFFFFFFFFu);
+
+        }
+
+    inline
+    std::uint32_t ConcurrentSlabManager::tag_of(std::uint64_t head) {
+
+        return std::uint32_t(head >> 32);
+
+        }
+
+    inline
+    void ConcurrentSlabManager::locate(size_t ind, unsigned & chunk, size_t & offset) {
+
+        // Chunk c starts at BASE * (2^c - 1):
+        chunk  = detail::bsr64((ind >> BASE_SHIFT) + 1);
+        offset = ind + BASE - (BASE << chunk);
+
+        }
+
+    inline
+    ConcurrentSlabManager::Chunk * ConcurrentSlabManager::chunk_for(size_t ind, size_t & offset) const {
+
+        unsigned c;
+
+        locate(ind, c, offset);
+
+        return chunk_arr[c].load(std::memory_order_acquire);
+
+        }
+
+    inline
+    ConcurrentSlabManager::Chunk * ConcurrentSlabManager::make_chunk(unsigned c) {
+
+        Chunk * rv = chunk_arr[c].load(std::memory_order_acquire);
+
+        if (rv != nullptr) return rv;
+
+        size_t n = (BASE << c);
+
+        Chunk * fresh = new Chunk;
+
+        fresh->next_arr = new std::atomic<Index>[n];
+        fresh->occ_arr  = new std::atomic<Word>[n / WORD_BITS];
+
+        for (size_t i = 0; i < n / WORD_BITS; i += 1) fresh->occ_arr[i].store(0, std::memory_order_relaxed);
+
+        // Another thread may have published the chunk in the meantime:
+        if (chunk_arr[c].compare_exchange_strong(rv, fresh, std::memory_order_acq_rel, std::memory_order_acquire))
+            return fresh;
+
+        delete[] fresh->next_arr;
+        delete[] fresh->occ_arr;
+        delete fresh;
+
+        return rv;
+
+        }
+
+    inline
+    ConcurrentSlabManager::Index ConcurrentSlabManager::acquire() {
+
+        size_t  offset;
+        Chunk * chunk;
+
+        std::uint64_t head = empty_head.load(std::memory_order_acquire);
+
+        while (index_of(head) != NULL_INDEX) {
+
+            Index rv = index_of(head);
+
+            chunk = chunk_for(rv, offset);
+
+            // May read a link that is being rewritten by a concurrent push;
+            // the tag makes the CAS fail in that case:
+            Index next = chunk->next_arr[offset].load(std::memory_order_relaxed);
+
+            if (empty_head.compare_exchange_weak(head, pack(next, tag_of(head) + 1),
+                                                 std::memory_order_acquire, std::memory_order_acquire)) {
+
+                chunk->occ_arr[offset / WORD_BITS].fetch_or(Word(1) << (offset % WORD_BITS), std::memory_order_relaxed);
+
+                return rv;
+
+                }
+
+            }
+
+        // Empty stack is exhausted - take a fresh slot:
+        size_t ind = bump.fetch_add(1, std::memory_order_relaxed);
+
+        if (ind >= size_t(NULL_INDEX)) {
+
+            bump.fetch_sub(1, std::memory_order_relaxed);
+
+            GEN_SLAB_THROW(std::length_error("ConcurrentSlabManager::acquire - Index type exhausted!"));
+
+            }
+
+        unsigned c;
+
+        locate(ind, c, offset);
+
+        chunk = make_chunk(c);
+
+        chunk->occ_arr[offset / WORD_BITS].fetch_or(Word(1) << (offset % WORD_BITS), std::memory_order_relaxed);
+
+        return Index(ind);
+
+        }
+
+    inline
+    void ConcurrentSlabManager::give_back(Index ind) {
+
+        SlabStatus st = try_give_back(ind);
+
+        if (st == SLAB_OUT_OF_BOUNDS) GEN_SLAB_THROW(std::out_of_range("ConcurrentSlabManager::give_back - Index out of bounds!"));
+        if (st == SLAB_NOT_ACQUIRED)  GEN_SLAB_THROW(std::logic_error("ConcurrentSlabManager::give_back - Element not acquired!"));
+
+        }
+
+    inline
+    SlabStatus ConcurrentSlabManager::try_give_back(Index ind) noexcept {
+
+        size_t  offset;
+        Chunk * chunk = (ind < size()) ? chunk_for(ind, offset) : nullptr;
+
+        if (chunk == nullptr) return SLAB_OUT_OF_BOUNDS;
+
+        // Clearing the bit atomically lets exactly one of several racing
+        // give_back() calls for the same slot through:
+        Word mask = Word(1) << (offset % WORD_BITS);
+        Word prev = chunk->occ_arr[offset / WORD_BITS].fetch_and(~mask, std::memory_order_relaxed);
+
+        if ((prev & mask) == 0) return SLAB_NOT_ACQUIRED;
+
+        std::uint64_t head = empty_head.load(std::memory_order_relaxed);
+
+        do {
+
+            chunk->next_arr[offset].store(index_of(head), std::memory_order_relaxed);
+
+            } while (!empty_head.compare_exchange_weak(head, pack(ind, tag_of(head) + 1),
+                                                       std::memory_order_release, std::memory_order_relaxed));
+
+        return SLAB_OK;
+
+        }
+
+    inline
+    bool ConcurrentSlabManager::is_slot_empty(Index ind) const {
+
+        if (ind >= size()) GEN_SLAB_THROW(std::out_of_range("ConcurrentSlabManager::is_empty - Index out of bounds!"));
+
+        size_t  offset;
+        Chunk * chunk = chunk_for(ind, offset);
+
+        // The slot's chunk may still be in the making:
+        if (chunk == nullptr) return true;
+
+        Word bits = chunk->occ_arr[offset / WORD_BITS].load(std::memory_order_relaxed);
+
+        return ((bits >> (offset % WORD_BITS)) & 1u) == 0;
+
+        }
+
+    inline
+    size_t ConcurrentSlabManager::size() const {
+
+        size_t rv = bump.load(std::memory_order_relaxed);
+
+        return (rv < size_t(NULL_INDEX)) ? rv : size_t(NULL_INDEX);
+
+        }
+
+    inline
+    size_t ConcurrentSlabManager::filled_count() const {
+
+        size_t rv = 0;
+
+        for (unsigned c = 0; c < MAX_CHUNKS; c += 1) {
+
+            Chunk * chunk = chunk_arr[c].load(std::memory_order_acquire);
+
+            if (chunk == nullptr) continue;
+
+            for (size_t w = 0; w < (BASE << c) / WORD_BITS; w += 1) {
+
+                rv += detail::popcount64(chunk->occ_arr[w].load(std::memory_order_relaxed));
+
+                }
+
+            }
+
+        return rv;
+
+        }
+
+    inline
+    void ConcurrentSlabManager::reserve(size_t n) {
+
+        if (n > size_t(NULL_INDEX)) n = size_t(NULL_INDEX);
+
+        if (n == 0) return;
+
+        unsigned c;
+        size_t   offset;
+
+        locate(n - 1, c, offset);
+
+        for (unsigned i = 0; i <= c; i += 1) make_chunk(i);
+
+        }
+
+    inline
+    void ConcurrentSlabManager::clear() {
+
+        for (unsigned c = 0; c < MAX_CHUNKS; c += 1) {
+
+            Chunk * chunk = chunk_arr[c].load(std::memory_order_relaxed);
+
+            if (chunk == nullptr) continue;
+
+            for (size_t w = 0; w < (BASE << c) / WORD_BITS; w += 1) chunk->occ_arr[w].store(0, std::memory_order_relaxed);
+
+            }
+
+        empty_head.store(pack(NULL_INDEX, 0), std::memory_order_relaxed);
+        bump.store(0, std::memory_order_relaxed);
+
+        }
+
+    // *** Implementation End *** //
+
+    }
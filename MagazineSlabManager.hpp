@@ -0,0 +1,368 @@
+#pragma once
+
+#include "SlabManager.hpp"
+
+#include <mutex>
+#include <vector>
+#include <iterator>
+
+namespace gen {
+
+    /// <summary> Shared slab manager fronted by per-thread slot caches ("magazines").
+    ///        Each thread owns a Magazine holding a small stack of acquired
+    ///        indices; acquire() and give_back() on the magazine touch only
+    ///        thread-local memory until the stack runs empty or full, at which
+    ///        point half a magazine is moved to or from the central manager in
+    ///        one batch under a mutex. Manager is the underlying
+    ///        BasicSlabManager instantiation. </summary>
+    ///
+    template <class Manager = SlabManager>
+    class MagazineSlabManager {
+
+        public:
+
+            typedef typename Manager::Index Index;
+
+            class Magazine;
+
+        private:
+
+            mutable std::mutex mtx;
+
+            Manager central;
+
+            size_t mag_size;
+
+            // Totals reported by magazines (guarded by mtx):
+            size_t hit_cnt;
+            size_t miss_cnt;
+
+        public:
+
+            MagazineSlabManager(const MagazineSlabManager & other) = delete;
+            MagazineSlabManager & operator=(const MagazineSlabManager & other) = delete;
+
+            /// <summary> Construct with n reserved slots and magazines holding up to
+            ///        magazine_size indices (min 2). </summary>
+            ///
+            explicit MagazineSlabManager(size_t magazine_size = 64, size_t n = 1);
+
+            /// <summary> Returns the capacity of each magazine. </summary>
+            ///
+            size_t magazine_size() const;
+
+            /// <summary> Acquire a slot directly from the central manager. </summary>
+            ///
+            Index acquire();
+
+            /// <summary> Give a slot back directly to the central manager. </summary>
+            ///
+            void give_back(Index ind);
+
+            /// <summary> give_back() that returns a status code instead of throwing. </summary>
+            ///
+            SlabStatus try_give_back(Index ind);
+
+            /// <summary> Returns the number of filled slots as seen by the central
+            ///        manager; slots cached in magazines count as filled. </summary>
+            ///
+            size_t filled_count() const;
+
+            /// <summary> Returns the number of magazine operations served without the
+            ///        central manager, as reported by magazines so far. </summary>
+            ///
+            size_t hits() const;
+
+            /// <summary> Returns the number of magazine operations that had to refill
+            ///        from or flush to the central manager, as reported so far. </summary>
+            ///
+            size_t misses() const;
+
+        };
+
+    /// <summary> Per-thread slot cache of a MagazineSlabManager. Not thread-safe -
+    ///        each thread uses its own (e.g. a thread_local or a member of a
+    ///        worker object). Must not outlive its manager. Slots given back
+    ///        to a magazine are only validated when they are flushed, so a
+    ///        slot must not be given back twice. </summary>
+    ///
+    template <class Manager>
+    class MagazineSlabManager<Manager>::Magazine {
+
+        private:
+
+            MagazineSlabManager * owner;
+
+            std::vector<Index> stack;
+
+            size_t hit_cnt;
+            size_t miss_cnt;
+
+            // Counters not yet added to the owner's totals:
+            size_t hit_pending;
+            size_t miss_pending;
+
+            void report();
+
+        public:
+
+            Magazine(const Magazine & other) = delete;
+            Magazine & operator=(const Magazine & other) = delete;
+
+            explicit Magazine(MagazineSlabManager & owner);
+
+            /// <summary> Flushes all cached slots back to the manager. </summary>
+            ///
+            ~Magazine();
+
+            /// <summary> Acquire a slot, refilling from the manager if the magazine is empty. </summary>
+            ///
+            Index acquire();
+
+            /// <summary> Give a slot back, flushing half the magazine if it is full. </summary>
+            ///
+            void give_back(Index ind);
+
+            /// <summary> Return all cached slots to the manager. </summary>
+            ///
+            void flush();
+
+            /// <summary> Returns the number of cached slots. </summary>
+            ///
+            size_t size() const;
+
+            /// <summary> Returns the number of operations served from the magazine. </summary>
+            ///
+            size_t hits() const;
+
+            /// <summary> Returns the number of operations that went to the manager. </summary>
+            ///
+            size_t misses() const;
+
+        };
+
+    // *** Implementation below: *** //
+
+    template <class Manager>
+    inline
+    MagazineSlabManager<Manager>::MagazineSlabManager(size_t magazine_size, size_t n)
+        : central(n)
+        , mag_size((magazine_size > 2) ? magazine_size : 2u)
+        , hit_cnt(0)
+        , miss_cnt(0) {
+
+        }
+
+    template <class Manager>
+    inline
+    size_t MagazineSlabManager<Manager>::magazine_size() const {
+
+        return mag_size;
+
+        }
+
+    template <class Manager>
+    inline
+    typename MagazineSlabManager<Manager>::Index MagazineSlabManager<Manager>::acquire() {
+
+        std::lock_guard<std::mutex> lock(mtx);
+
+        return central.acquire();
+
+        }
+
+    template <class Manager>
+    inline
+    void MagazineSlabManager<Manager>::give_back(Index ind) {
+
+        std::lock_guard<std::mutex> lock(mtx);
+
+        central.give_back(ind);
+
+        }
+
+    template <class Manager>
+    inline
+    SlabStatus MagazineSlabManager<Manager>::try_give_back(Index ind) {
+
+        std::lock_guard<std::mutex> lock(mtx);
+
+        return central.try_give_back(ind);
+
+        }
+
+    template <class Manager>
+    inline
+    size_t MagazineSlabManager<Manager>::filled_count() const {
+
+        std::lock_guard<std::mutex> lock(mtx);
+
+        return central.filled_count();
+
+        }
+
+    template <class Manager>
+    inline
+    size_t MagazineSlabManager<Manager>::hits() const {
+
+        std::lock_guard<std::mutex> lock(mtx);
+
+        return hit_cnt;
+
+        }
+
+    template <class Manager>
+    inline
+    size_t MagazineSlabManager<Manager>::misses() const {
+
+        std::lock_guard<std::mutex> lock(mtx);
+
+        return miss_cnt;
+
+        }
+
+    // Magazine:
+
+    template <class Manager>
+    inline
+    MagazineSlabManager<Manager>::Magazine::Magazine(MagazineSlabManager & owner)
+        : owner(&owner)
+        , hit_cnt(0)
+        , miss_cnt(0)
+        , hit_pending(0)
+        , miss_pending(0) {
+
+        stack.reserve(owner.mag_size);
+
+        }
+
+    template <class Manager>
+    inline
+    MagazineSlabManager<Manager>::Magazine::~Magazine() {
+
+        flush();
+
+        }
+
+    template <class Manager>
+    inline
+    void MagazineSlabManager<Manager>::Magazine::report() {
+
+        // Called with owner->mtx held:
+        owner->hit_cnt  += hit_pending;
+        owner->miss_cnt += miss_pending;
+
+        hit_pending  = 0;
+        miss_pending = 0;
+
+        }
+
+    template <class Manager>
+    inline
+    typename MagazineSlabManager<Manager>::Index MagazineSlabManager<Manager>::Magazine::acquire() {
+
+        if (!stack.empty()) {
+
+            hit_cnt     += 1;
+            hit_pending += 1;
+
+            Index rv = stack.back();
+            stack.pop_back();
+
+            return rv;
+
+            }
+
+        miss_cnt     += 1;
+        miss_pending += 1;
+
+        {
+            std::lock_guard<std::mutex> lock(owner->mtx);
+
+            owner->central.acquire_n(owner->mag_size / 2, std::back_inserter(stack));
+
+            report();
+        }
+
+        Index rv = stack.back();
+        stack.pop_back();
+
+        return rv;
+
+        }
+
+    template <class Manager>
+    inline
+    void MagazineSlabManager<Manager>::Magazine::give_back(Index ind) {
+
+        if (stack.size() < owner->mag_size) {
+
+            hit_cnt     += 1;
+            hit_pending += 1;
+
+            stack.push_back(ind);
+
+            return;
+
+            }
+
+        miss_cnt     += 1;
+        miss_pending += 1;
+
+        // Keep the most recently cached half, flush the older one:
+        auto half = stack.begin() + std::ptrdiff_t(owner->mag_size / 2);
+
+        {
+            std::lock_guard<std::mutex> lock(owner->mtx);
+
+            owner->central.give_back_n(stack.begin(), half);
+
+            report();
+        }
+
+        stack.erase(stack.begin(), half);
+        stack.push_back(ind);
+
+        }
+
+    template <class Manager>
+    inline
+    void MagazineSlabManager<Manager>::Magazine::flush() {
+
+        std::lock_guard<std::mutex> lock(owner->mtx);
+
+        owner->central.give_back_n(stack.begin(), stack.end());
+
+        report();
+
+        stack.clear();
+
+        }
+
+    template <class Manager>
+    inline
+    size_t MagazineSlabManager<Manager>::Magazine::size() const {
+
+        return stack.size();
+
+        }
+
+    template <class Manager>
+    inline
+    size_t MagazineSlabManager<Manager>::Magazine::hits() const {
+
+        return hit_cnt;
+
+        }
+
+    template <class Manager>
+    inline
+    size_t MagazineSlabManager<Manager>::Magazine::misses() const {
+
+        return miss_cnt;
+
+        }
+
+    // *** Implementation End *** //
+
+    }
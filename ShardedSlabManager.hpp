@@ -0,0 +1,368 @@
+#pragma once
+
+#include "SlabManager.hpp"
+
+#include <mutex>
+#include <atomic>
+#include <memory>
+#include <thread>
+#include <stdexcept>
+
+namespace gen {
+
+    /// <summary> Thread-safe slab manager that partitions the index space between
+    ///        a power-of-two number of shards, each a BasicSlabManager behind
+    ///        its own mutex. The low bits of an index name its shard, so
+    ///        give_back() finds the owner in O(1). Threads acquire from a home
+    ///        shard handed out round-robin on their first call and steal empty slots from
+    ///        other shards before growing their own, which then doubles so
+    ///        the other shards are not polled again on every acquire. </summary>
+    ///
+    template <class IndexT = size_t>
+    class ShardedSlabManager {
+
+        public:
+
+            typedef IndexT Index;
+
+        private:
+
+            struct Shard {
+
+                std::mutex mtx;
+
+                BasicSlabManager<IndexT> slots;
+
+                // slots.empty_count() as of the last change, readable without
+                // the lock so stealing can skip dry shards:
+                std::atomic<size_t> empty_hint;
+
+                char pad[64]; // Keep neighbouring shards off each other's cache lines
+
+                };
+
+            std::unique_ptr<Shard[]> shard_arr;
+
+            unsigned shard_bits;
+            size_t   shard_mask;
+
+            Index to_global(size_t shard, Index local) const;
+
+            size_t max_local() const;
+
+            bool try_steal(size_t home, Index & rv);
+
+            static void update_hint(Shard & shard);
+
+        public:
+
+            ShardedSlabManager(const ShardedSlabManager & other) = delete;
+            ShardedSlabManager & operator=(const ShardedSlabManager & other) = delete;
+
+            /// <summary> Construct with shard_count shards (rounded up to a power of
+            ///        two; 0 picks the number of hardware threads), each with
+            ///        n_per_shard reserved slots. </summary>
+            ///
+            explicit ShardedSlabManager(size_t shard_count = 0, size_t n_per_shard = 1);
+
+            /// <summary> Returns the number of shards. </summary>
+            ///
+            size_t shard_count() const;
+
+            /// <summary> Returns the shard the calling thread acquires from. Threads
+            ///        are given home shards round-robin in the order of their
+            ///        first call, so N threads on N shards never share one. </summary>
+            ///
+            size_t home_shard() const;
+
+            /// <summary> Returns the shard owning the given index. </summary>
+            ///
+            size_t shard_of(Index ind) const;
+
+            /// <summary> Acquire a slot from the calling thread's home shard, stealing
+            ///        from another shard if the home shard has no empty slots
+            ///        and doubling the home shard if no other shard has any. </summary>
+            ///
+            Index acquire();
+
+            /// <summary> Acquire a slot using 'shard' as the home shard. </summary>
+            ///
+            Index acquire(size_t shard);
+
+            /// <summary> Give a previously acquired slot back to its shard. </summary>
+            ///
+            void give_back(Index ind);
+
+            /// <summary> give_back() that returns a status code instead of throwing. </summary>
+            ///
+            SlabStatus try_give_back(Index ind);
+
+            /// <summary> Checks if the slot with the given index is empty. </summary>
+            ///
+            bool is_slot_empty(Index ind) const;
+
+            /// <summary> Returns the number of filled slots (sum over shards). </summary>
+            ///
+            size_t filled_count() const;
+
+            /// <summary> Returns the number of empty slots (sum over shards). </summary>
+            ///
+            size_t empty_count() const;
+
+        };
+
+    // *** Implementation below: *** //
+
+    template <class IndexT>
+    inline
+    ShardedSlabManager<IndexT>::ShardedSlabManager(size_t shard_count, size_t n_per_shard) {
+
+        if (shard_count == 0) shard_count = std::thread::hardware_concurrency();
+        if (shard_count == 0) shard_count = 1;
+
+        shard_bits = 0;
+        while ((size_t(1) << shard_bits) < shard_count) shard_bits += 1;
+
+        if (shard_bits >= sizeof(Index) * 8) GEN_SLAB_THROW(std::length_error("ShardedSlabManager - Too many shards for Index!"));
+
+        shard_mask = (size_t(1) << shard_bits) - 1;
+
+        if (n_per_shard > max_local()) GEN_SLAB_THROW(std::length_error("ShardedSlabManager - Size exceeds the range of Index!"));
+
+        shard_arr.reset(new Shard[shard_mask + 1]);
+
+        for (size_t i = 0; i <= shard_mask; i += 1) {
+
+            shard_arr[i].slots.resize(n_per_shard);
+
+            update_hint(shard_arr[i]);
+
+            }
+
+        }
+
+    template <class IndexT>
+    inline
+    void ShardedSlabManager<IndexT>::update_hint(Shard & shard) {
+
+        // Called with shard.mtx held:
+        shard.empty_hint.store(shard.slots.empty_count(), std::memory_order_relaxed);
+
+        }
+
+    template <class IndexT>
+    inline
+    typename ShardedSlabManager<IndexT>::Index ShardedSlabManager<IndexT>::to_global(size_t shard, Index local) const {
+
+        return Index((size_t(local) << shard_bits) | shard);
+
+        }
+
+    template <class IndexT>
+    inline
+    size_t ShardedSlabManager<IndexT>::max_local() const {
+
+        // Keep the largest global index below NULL_INDEX of the shards:
+        return BasicSlabManager<IndexT>::max_size() >> shard_bits;
+
+        }
+
+    template <class IndexT>
+    inline
+    size_t ShardedSlabManager<IndexT>::shard_count() const {
+
+        return shard_mask + 1;
+
+        }
+
+    template <class IndexT>
+    inline
+    size_t ShardedSlabManager<IndexT>::home_shard() const {
+
+        // Not hashed from the thread id: pthread ids share their low bits and
+        // some standard libraries hash them by identity, so hashing piled
+        // every thread onto one shard:
+        static std::atomic<size_t> next_home(0);
+
+        static thread_local size_t home = next_home.fetch_add(1, std::memory_order_relaxed);
+
+        return home & shard_mask;
+
+        }
+
+    template <class IndexT>
+    inline
+    size_t ShardedSlabManager<IndexT>::shard_of(Index ind) const {
+
+        return size_t(ind) & shard_mask;
+
+        }
+
+    template <class IndexT>
+    inline
+    typename ShardedSlabManager<IndexT>::Index ShardedSlabManager<IndexT>::acquire() {
+
+        return acquire(home_shard());
+
+        }
+
+    template <class IndexT>
+    inline
+    bool ShardedSlabManager<IndexT>::try_steal(size_t home, Index & rv) {
+
+        // Skip shards that are busy or have nothing to give:
+        for (size_t i = 1; i <= shard_mask; i += 1) {
+
+            size_t  victim = (home + i) & shard_mask;
+            Shard & shard  = shard_arr[victim];
+
+            // The hint may be stale; it only saves locking shards that are dry:
+            if (shard.empty_hint.load(std::memory_order_relaxed) == 0) continue;
+
+            std::unique_lock<std::mutex> lock(shard.mtx, std::try_to_lock);
+
+            if (!lock.owns_lock() || shard.slots.empty_count() == 0) continue;
+
+            rv = to_global(victim, shard.slots.acquire());
+
+            update_hint(shard);
+
+            return true;
+
+            }
+
+        return false;
+
+        }
+
+    template <class IndexT>
+    inline
+    typename ShardedSlabManager<IndexT>::Index ShardedSlabManager<IndexT>::acquire(size_t home) {
+
+        home &= shard_mask;
+
+        Shard & shard = shard_arr[home];
+
+        {
+            std::lock_guard<std::mutex> lock(shard.mtx);
+
+            if (shard.slots.empty_count() > 0) {
+
+                Index rv = to_global(home, shard.slots.acquire());
+
+                update_hint(shard);
+
+                return rv;
+
+                }
+        }
+
+        Index rv;
+
+        if (try_steal(home, rv)) return rv;
+
+        // Nothing to steal - grow the home shard. Doubling keeps the polls of
+        // the other shards down to one per doubling while the pool grows:
+        std::lock_guard<std::mutex> lock(shard.mtx);
+
+        if (shard.slots.empty_count() == 0) {
+
+            size_t ss = shard.slots.size();
+
+            if (ss >= max_local()) GEN_SLAB_THROW(std::length_error("ShardedSlabManager::acquire - Index type exhausted!"));
+
+            size_t grow = (ss > 0) ? ss : 1;
+
+            shard.slots.resize((grow > max_local() - ss) ? max_local() : ss + grow);
+
+            }
+
+        rv = to_global(home, shard.slots.acquire());
+
+        update_hint(shard);
+
+        return rv;
+
+        }
+
+    template <class IndexT>
+    inline
+    void ShardedSlabManager<IndexT>::give_back(Index ind) {
+
+        Shard & shard = shard_arr[shard_of(ind)];
+
+        std::lock_guard<std::mutex> lock(shard.mtx);
+
+        shard.slots.give_back(Index(size_t(ind) >> shard_bits));
+
+        update_hint(shard);
+
+        }
+
+    template <class IndexT>
+    inline
+    SlabStatus ShardedSlabManager<IndexT>::try_give_back(Index ind) {
+
+        Shard & shard = shard_arr[shard_of(ind)];
+
+        std::lock_guard<std::mutex> lock(shard.mtx);
+
+        SlabStatus rv = shard.slots.try_give_back(Index(size_t(ind) >> shard_bits));
+
+        update_hint(shard);
+
+        return rv;
+
+        }
+
+    template <class IndexT>
+    inline
+    bool ShardedSlabManager<IndexT>::is_slot_empty(Index ind) const {
+
+        Shard & shard = shard_arr[shard_of(ind)];
+
+        std::lock_guard<std::mutex> lock(shard.mtx);
+
+        return shard.slots.is_slot_empty(Index(size_t(ind) >> shard_bits));
+
+        }
+
+    template <class IndexT>
+    inline
+    size_t ShardedSlabManager<IndexT>::filled_count() const {
+
+        size_t rv = 0;
+
+        for (size_t i = 0; i <= shard_mask; i += 1) {
+
+            std::lock_guard<std::mutex> lock(shard_arr[i].mtx);
+
+            rv += shard_arr[i].slots.filled_count();
+
+            }
+
+        return rv;
+
+        }
+
+    template <class IndexT>
+    inline
+    size_t ShardedSlabManager<IndexT>::empty_count() const {
+
+        size_t rv = 0;
+
+        for (size_t i = 0; i <= shard_mask; i += 1) {
+
+            std::lock_guard<std::mutex> lock(shard_arr[i].mtx);
+
+            rv += shard_arr[i].slots.empty_count();
+
+            }
+
+        return rv;
+
+        }
+
+    // *** Implementation End *** //
+
+    }
@@ -0,0 +1,76 @@
+#pragma once
+
+#include <cstdlib>
+
+// Build configuration shared by all slab headers.
+//
+// GEN_SLAB_NO_EXCEPTIONS selects the exception-free mode. It is defined
+// automatically when the compiler has exceptions disabled (-fno-exceptions,
+// /EHs-c-) and may also be defined by hand. In this mode errors that would
+// throw call std::abort() instead. Bad indices and size limits can be
+// handled without aborting through the try_ methods, which return a
+// SlabStatus:
+//
+//     BasicSlabManager   try_give_back(), try_give_back_n(), try_give_back_range(),
+//                        try_acquire(Index &), try_acquire() (C++17,
+//                        std::optional), try_acquire_n(), try_acquire_near(),
+//                        try_acquire_range()
+//     SlabVector         try_erase(), try_at() (nullptr instead of a status)
+//     StaticSlabManager, ConcurrentSlabManager, ShardedSlabManager,
+//     MagazineSlabManager, BoundedSlabManager, AsyncSlabManager
+//                        try_give_back()
+//
+// Everything else still aborts on error:
+//
+//     - is_slot_empty() and handle() with an out-of-range index (check
+//       against size() first), and handle() on an empty slot
+//     - give_back(Handle) with a stale handle (check is_live() first)
+//     - acquire() of any manager, acquire_handle() and SlabVector::emplace()
+//       past the size limit (BasicSlabManager::try_acquire(Index &) reports
+//       it instead; follow it with handle() for a Handle)
+//     - MagazineSlabManager::Magazine acquire(), give_back() and flush(),
+//       which refill and drain through the central manager's acquire_n() and
+//       give_back_n(): past its size limit, or once a bad index given back
+//       to the magazine is flushed
+//     - resize() past the size limit, exhausting the Index range or a
+//       storage reservation, and running out of memory
+
+#if !defined(GEN_SLAB_NO_EXCEPTIONS)
+#if !defined(__cpp_exceptions) && !defined(__EXCEPTIONS) && !(defined(_MSC_VER) && defined(_CPPUNWIND))
+#define GEN_SLAB_NO_EXCEPTIONS 1
+#endif
+#endif
+
+#if defined(GEN_SLAB_NO_EXCEPTIONS)
+#define GEN_SLAB_THROW(ex)       std::abort()
+#define GEN_SLAB_TRY             if (true)
+#define GEN_SLAB_CATCH_ALL       else
+#define GEN_SLAB_RETHROW         ((void)0)
+#else
+#define GEN_SLAB_THROW(ex)       throw ex
+#define GEN_SLAB_TRY             try
+#define GEN_SLAB_CATCH_ALL       catch (...)
+#define GEN_SLAB_RETHROW         throw
+#endif
+
+// try_acquire() returns std::optional, which needs C++17:
+#if __cplusplus >= 201703L || (defined(_MSVC_LANG) && _MSVC_LANG >= 201703L)
+#include <optional>
+#define GEN_SLAB_HAS_OPTIONAL 1
+#endif
+
+namespace gen {
+
+    /// <summary> Result of the non-throwing try_ methods. </summary>
+    ///
+    enum SlabStatus : unsigned {
+
+        SLAB_OK = 0,
+        SLAB_OUT_OF_BOUNDS,  // Index not below size()
+        SLAB_NOT_ACQUIRED,   // Slot is empty
+        SLAB_LIMIT_REACHED,  // Would have to grow past size_limit()
+        SLAB_EMPTY_RANGE     // Range of zero slots requested
+
+        };
+
+    }
\ No newline at end of file
@@ -1,75 +1,415 @@
 #pragma once
 
+#include "SlabStorage.hpp"
+
 #include <vector>
+#include <cassert>
 #include <stdexcept>
+#include <cstdint>
+#include <cstddef>
+#include <iterator>
+#include <limits>
+#include <type_traits>
+
+#if defined(_MSC_VER)
+#include <intrin.h>
+#endif
 
 namespace gen {
     
-    class SlabManager {
+    namespace detail {
+
+        /// <summary> Returns the position of the lowest set bit of a non-zero word. </summary>
+        ///
+        inline unsigned ctz64(std::uint64_t w) {
+
+        #if defined(_MSC_VER) && (defined(_M_X64) || defined(_M_ARM64))
+            unsigned long rv;
+            _BitScanForward64(&rv, w);
+            return unsigned(rv);
+        #elif defined(__GNUC__) || defined(__clang__)
+            return unsigned(__builtin_ctzll(w));
+        #else
+            unsigned rv = 0;
+            while ((w & 1u) == 0) { w >>= 1; rv += 1; }
+            return rv;
+        #endif
+
+            }
+
+        /// <summary> Returns the position of the highest set bit of a non-zero word. </summary>
+        ///
+        inline unsigned bsr64(std::uint64_t w) {
+
+        #if defined(_MSC_VER) && (defined(_M_X64) || defined(_M_ARM64))
+            unsigned long rv;
+            _BitScanReverse64(&rv, w);
+            return unsigned(rv);
+        #elif defined(__GNUC__) || defined(__clang__)
+            return 63u - unsigned(__builtin_clzll(w));
+        #else
+            unsigned rv = 0;
+            while (w >>= 1) rv += 1;
+            return rv;
+        #endif
+
+            }
+
+        /// <summary> Returns the number of set bits in a word. </summary>
+        ///
+        inline unsigned popcount64(std::uint64_t w) {
+
+        #if defined(_MSC_VER) && defined(_M_X64)
+            return unsigned(__popcnt64(w));
+        #elif defined(__GNUC__) || defined(__clang__)
+            return unsigned(__builtin_popcountll(w));
+        #else
+            unsigned rv = 0;
+            for (; w != 0; w &= (w - 1)) rv += 1;
+            return rv;
+        #endif
+
+            }
+
+        }
+
+    /// <summary> Compile-time options of BasicSlabManager (combine with |). </summary>
+    ///
+    enum SlabOptions : unsigned {
+
+        SLAB_DEFAULT        = 0,
+        SLAB_GENERATIONS    = 1u << 0, // Keep a generation counter per slot (enables Handle)
+        SLAB_LOWEST_FIRST   = 1u << 1, // acquire() always returns the lowest empty index
+        SLAB_NO_FILLED_LIST = 1u << 2  // Keep only a singly linked empty list (see BasicSlabManager)
+
+        };
+
+    /// <summary> Manages empty and filled slots of a slab. IndexT is the unsigned
+    ///        integer type used for slot indices and list links; a narrower type
+    ///        shrinks the per-slot metadata but caps the number of slots.
+    ///        Options is a combination of SlabOptions flags. Storage is the
+    ///        policy for the metadata arrays (see SlabStorage.hpp).
+    ///
+    ///        With SLAB_NO_FILLED_LIST there is no list of filled slots and the
+    ///        empty list is singly linked, so a slot costs one index and one
+    ///        bit and acquire() / give_back() only touch the list head. Filled
+    ///        slots are then iterated by scanning the occupancy bitmap, and
+    ///        acquire_near(), acquire_range(), compact_step() and
+    ///        SLAB_LOWEST_FIRST, which take slots from the middle of the empty
+    ///        list, are unavailable. </summary>
+    ///
+    template <class IndexT, unsigned Options = SLAB_DEFAULT, class Storage = VectorStorage>
+    class BasicSlabManager {
+
+            static_assert(std::is_integral<IndexT>::value && std::is_unsigned<IndexT>::value,
+                          "BasicSlabManager - IndexT must be an unsigned integer type!");
+
+            static_assert((Options & SLAB_NO_FILLED_LIST) == 0 || (Options & SLAB_LOWEST_FIRST) == 0,
+                          "BasicSlabManager - SLAB_LOWEST_FIRST cannot be combined with SLAB_NO_FILLED_LIST!");
 
         public:
 
-            typedef size_t Index;
+            typedef IndexT Index;
 
-        private:
+            typedef Storage StoragePolicy;
 
-            static const Index NULL_INDEX = Index(-1);
+            typedef std::uint32_t Generation;
 
-            struct Elem {
-                
-                bool is_empty;
+            /// <summary> Slot index paired with the generation of the slot at the
+            ///        time it was acquired. Goes stale once the slot is given back,
+            ///        even if the index is later reused. Wraps after 2^32 reuses
+            ///        of the same slot. Requires SLAB_GENERATIONS. </summary>
+            ///
+            struct Handle {
 
-                Index prev;
-                Index next;
+                Index      index;
+                Generation generation;
 
-                Elem()
-                    : is_empty(true)
-                    , prev(NULL_INDEX)
-                    , next(NULL_INDEX)
-                    { }
+                bool operator==(const Handle & other) const { return index == other.index && generation == other.generation; }
+                bool operator!=(const Handle & other) const { return !(*this == other); }
 
                 };
 
+            /// <summary> Run selection of acquire_range(). </summary>
+            ///
+            enum Fit {
+
+                FIRST_FIT, // Lowest run that is long enough
+                BEST_FIT   // Shortest run that is long enough (lowest among equals)
+
+                };
+
+        private:
+
+            static const bool HAS_GENERATIONS = (Options & SLAB_GENERATIONS)    != 0;
+            static const bool LOWEST_FIRST    = (Options & SLAB_LOWEST_FIRST)   != 0;
+            static const bool NO_FILLED_LIST  = (Options & SLAB_NO_FILLED_LIST) != 0;
+
+            static const Index NULL_INDEX = Index(-1);
+
+            typedef std::uint64_t Word;
+
+            static const size_t WORD_BITS = 64;
+
+            // acquire_near() searches the hint's bitmap word and this many
+            // words on either side of it:
+            static const size_t NEAR_WORDS = 8;
+
             Index  empty_head;
             Index filled_head;
 
             size_t  empty_cnt;
             size_t filled_cnt;
 
-            std::vector<Elem> elem_vec;
+            size_t slot_cnt;
+            size_t limit_cnt; // Growth stops here (max_size() unless set_size_limit())
+
+            // Upper bound on the filled slots: every slot at or past it is
+            // empty. Raised by set_bit() and lowered to the exact value when
+            // a downsize scans for the last filled slot, so repeated trims
+            // do not scan the same empties again.
+            size_t filled_end;
+
+            // Slot metadata is stored as a structure of arrays: occupancy is
+            // packed into a bitmap (bit set = slot filled) so that queries and
+            // scans touch one bit per slot, while the links of the empty and
+            // filled lists are kept in arrays of their own. With
+            // SLAB_NO_FILLED_LIST prev_vec stays empty and next_vec only
+            // links the empty list.
+            //
+            // The arrays only cover the slots touched so far (the high-water
+            // mark is next_vec.size()). Slots from there up to slot_cnt are
+            // empty but not linked into the empty list; acquire() bumps the
+            // mark once the empty list runs out. This keeps clear(), the
+            // constructors and upsizing O(1).
+            typename Storage::template Array<Word>  occ_vec;
+            typename Storage::template Array<Index> prev_vec;
+            typename Storage::template Array<Index> next_vec;
+
+            // Per-slot generations (SLAB_GENERATIONS only). Unlike the arrays
+            // above this one never shrinks, so a slot keeps counting up across
+            // clear() and trimming and old handles can never match it again.
+            typename Storage::template Array<Generation> gen_vec;
+
+            // Summary bitmaps (SLAB_LOWEST_FIRST only): a bit of full_lvl[0] is
+            // set when the corresponding word of occ_vec is full, and a bit of
+            // full_lvl[k] when the corresponding word of full_lvl[k - 1] is.
+            // Levels are added as the bitmap grows until the top one
+            // (full_lvl[full_depth - 1]) is a single word, so the lowest empty
+            // slot is found with one ctz per level - O(log64 n) - and no scan.
+            static const size_t FULL_LEVELS = (LOWEST_FIRST) ? (sizeof(Index) * 8 + 5) / 6 : 1;
+
+            typename Storage::template Array<Word> full_lvl[FULL_LEVELS];
+
+            size_t full_depth;
 
             void initialize(size_t n);
 
+            void resize_words(size_t wcnt);
+
+            size_t lowest_empty() const;
+
+            size_t touched() const;
+
+            Index touch_filled();
+
+            void touch_empty();
+
+            void unlink_empty(Index ind);
+
+            void take_empty(Index ind);
+
+            void unlink_tail(size_t from);
+
+            void relink_empty();
+
+            size_t find_near(size_t hint) const;
+
+            size_t next_set(size_t pos, size_t end) const;
+            size_t next_clear(size_t pos, size_t end) const;
+
+            size_t find_range(size_t n, Fit fit) const;
+
+            void take_range(size_t first, size_t n);
+
+            SlabStatus check_range(Index first, size_t n) const;
+
+            template <class ForwardIt>
+            SlabStatus release_n(ForwardIt first, ForwardIt last);
+
+            bool at_limit() const;
+
+            void touch_generation(size_t ind);
+
+            size_t last_filled() const;
+
+            size_t prev_set(size_t pos) const;
+
+            template <class Fn>
+            bool compact_moves(size_t budget, Fn fn);
+
+            static size_t words_for(size_t n);
+
+            static size_t checked_size(size_t n);
+
+            bool can_grow(size_t base, size_t n) const;
+
+            bool test_bit(size_t ind) const;
+            void  set_bit(size_t ind);
+            void clear_bit(size_t ind);
+
         public:
 
-            SlabManager(const SlabManager & other) = default;
-            SlabManager(SlabManager && other) = default;
+            BasicSlabManager(const BasicSlabManager & other) = default;
+            BasicSlabManager(BasicSlabManager && other) = default;
 
-            SlabManager & operator=(const SlabManager & other) = default;
-            SlabManager & operator=(SlabManager && other) = default;
+            BasicSlabManager & operator=(const BasicSlabManager & other) = default;
+            BasicSlabManager & operator=(BasicSlabManager && other) = default;
 
             /// <summary> Construct with one slot reserved. </summary>
             ///
-            SlabManager();
+            BasicSlabManager();
 
-            /// <summary> Construct with n reserved slots (min 1). </summary>
+            /// <summary> Construct with n reserved slots (min 1). Slots are
+            ///        initialized lazily, so only the allocation depends on n. </summary>
             ///
-            SlabManager(size_t n);
+            BasicSlabManager(size_t n);
 
             /// <summary> Acquire a slot (it will be marked as not empty).
-            ///        Method returns the slot's index (use it to free() it later). </summary>
+            ///        Method returns the slot's index (use it to free() it later).
+            ///        With SLAB_LOWEST_FIRST this is the lowest empty index, so
+            ///        filled slots stay packed at the front and trimming can
+            ///        reclaim the tail; otherwise the most recently given back.
+            ///        Throws std::length_error if the manager would have to grow
+            ///        past size_limit(). </summary>
             ///
             Index acquire();
 
+        #if defined(GEN_SLAB_HAS_OPTIONAL)
+            /// <summary> acquire() that returns std::nullopt instead of throwing if the
+            ///        manager would have to grow past size_limit(). C++17. </summary>
+            ///
+            std::optional<Index> try_acquire();
+        #endif
+
+            /// <summary> acquire() into out that returns SLAB_LIMIT_REACHED instead of
+            ///        throwing if the manager would have to grow past
+            ///        size_limit(). </summary>
+            ///
+            SlabStatus try_acquire(Index & out);
+
+            /// <summary> Acquire an empty slot close to hint - in hint's 64-slot bitmap
+            ///        word if possible (the same cache line of a parallel array of
+            ///        small objects), otherwise within 8 words on either side -
+            ///        and fall back to acquire() if there is none. The search
+            ///        cost is bounded regardless of size. Throws
+            ///        std::out_of_range if hint is out of bounds. Not available
+            ///        with SLAB_NO_FILLED_LIST. </summary>
+            ///
+            Index acquire_near(Index hint);
+
+            /// <summary> acquire_near() into out that returns SLAB_OUT_OF_BOUNDS or
+            ///        SLAB_LIMIT_REACHED instead of throwing. </summary>
+            ///
+            SlabStatus try_acquire_near(Index hint, Index & out);
+
+            /// <summary> Acquire n adjacent slots [rv, rv + n) and return the first index.
+            ///        Runs of empty slots are found by scanning the occupancy
+            ///        bitmap; fit picks the first or the best fitting run. If no
+            ///        run is long enough, the trailing run is extended by growing.
+            ///        Throws std::invalid_argument if n is 0 and std::length_error
+            ///        if the manager would have to grow past size_limit(). Not
+            ///        available with SLAB_NO_FILLED_LIST. </summary>
+            ///
+            Index acquire_range(size_t n, Fit fit = FIRST_FIT);
+
+            /// <summary> acquire_range() that writes the first index to out and returns
+            ///        SLAB_EMPTY_RANGE or SLAB_LIMIT_REACHED instead of throwing. </summary>
+            ///
+            SlabStatus try_acquire_range(size_t n, Index & out, Fit fit = FIRST_FIT);
+
+            /// <summary> Give back the n adjacent slots [first, first + n). Nothing is
+            ///        given back and an exception is thrown if any of them is out
+            ///        of bounds or empty. </summary>
+            ///
+            void give_back_range(Index first, size_t n);
+
+            /// <summary> give_back_range() that returns a status code instead of throwing;
+            ///        nothing is changed unless SLAB_OK is returned. </summary>
+            ///
+            SlabStatus try_give_back_range(Index first, size_t n) noexcept;
+
             /// <summary> Give a previously acquired element back to the manager for use. </summary>
             ///
             void give_back(Index ind);
 
+            /// <summary> give_back() that reports failure with a status code instead of
+            ///        throwing; nothing is changed unless SLAB_OK is returned. </summary>
+            ///
+            SlabStatus try_give_back(Index ind) noexcept;
+
+            /// <summary> Acquire n slots at once and write their indices to out.
+            ///        The slots are unlinked from the empty list as one run, and
+            ///        if there are not enough empty slots the manager grows once
+            ///        by the shortfall. Returns the advanced output iterator. </summary>
+            ///
+            template <class OutputIt>
+            OutputIt acquire_n(size_t n, OutputIt out);
+
+            /// <summary> acquire_n() that returns SLAB_LIMIT_REACHED instead of throwing;
+            ///        nothing is acquired in that case. </summary>
+            ///
+            template <class OutputIt>
+            SlabStatus try_acquire_n(size_t n, OutputIt out);
+
+            /// <summary> Give back all slots in [first, last). The whole batch is
+            ///        validated first - if any index is out of bounds, empty or
+            ///        repeated, nothing is given back and an exception is thrown. </summary>
+            ///
+            template <class ForwardIt>
+            void give_back_n(ForwardIt first, ForwardIt last);
+
+            /// <summary> give_back_n() that returns the status of the first bad index
+            ///        instead of throwing; nothing is given back in that case. </summary>
+            ///
+            template <class ForwardIt>
+            SlabStatus try_give_back_n(ForwardIt first, ForwardIt last);
+
             /// <summary> Checks if the slot with the given index is empty. </summary>
             ///
             bool is_slot_empty(Index ind) const;
 
-            /// <summary> Mark all slots as empty. </summary>
+            // UNCHECKED VARIANTS (preconditions are only asserted in debug builds):
+
+            /// <summary> give_back() for a slot known to be filled. </summary>
+            ///
+            void give_back_unchecked(Index ind) noexcept;
+
+            /// <summary> is_slot_empty() for an index known to be below size(). </summary>
+            ///
+            bool is_slot_empty_unchecked(Index ind) const noexcept;
+
+            // GENERATIONAL HANDLES (SLAB_GENERATIONS only):
+
+            /// <summary> Acquire a slot and return a handle to it. </summary>
+            ///
+            Handle acquire_handle();
+
+            /// <summary> Returns a handle to a filled slot. </summary>
+            ///
+            Handle handle(Index ind) const;
+
+            /// <summary> Give back the slot referred to by h. Throws if h is stale. </summary>
+            ///
+            void give_back(Handle h);
+
+            /// <summary> Checks that h refers to a filled slot that has not been
+            ///        given back since h was obtained. </summary>
+            ///
+            bool is_live(Handle h) const;
+
+            /// <summary> Mark all slots as empty. O(1) - slots are re-initialized
+            ///        lazily as they are acquired again. </summary>
             ///
             void clear();
 
@@ -77,10 +417,24 @@ namespace gen {
             ///
             size_t size() const;
 
-            /// <summary> Returns the current capacity of the underlying vector. </summary>
+            /// <summary> Returns the current capacity of the underlying storage. </summary>
             ///
             size_t capacity() const;
 
+            /// <summary> Returns the largest number of slots addressable with Index. </summary>
+            ///
+            static size_t max_size();
+
+            /// <summary> Cap the number of slots: acquire() and the other growing
+            ///        methods fail rather than grow past n (clamped to max_size()).
+            ///        Does not shrink the manager. </summary>
+            ///
+            void set_size_limit(size_t n);
+
+            /// <summary> Returns the cap set by set_size_limit() (max_size() by default). </summary>
+            ///
+            size_t size_limit() const;
+
             /// <summary> Returns the number of empty slots. </summary>
             ///
             size_t empty_count() const;
@@ -91,17 +445,23 @@ namespace gen {
 
             /// <summary> Upsize to make more empty slots or downsize to shave off
             ///        excess empty slots. Downsizing is a non-binding request
-            ///        and will never destroy non-empty slots. </summary>
+            ///        and will never destroy non-empty slots. Throws
+            ///        std::length_error if newsize exceeds size_limit(). With
+            ///        SLAB_NO_FILLED_LIST trimming walks the empty list until it
+            ///        has met every trimmed slot: O(trimmed) when they were the
+            ///        last given back, O(empty slots) at worst. </summary>
             ///
             void resize(size_t newsize);
 
-            /// <summary> Instruct the underlying vector to allocate memory large
+            /// <summary> Instruct the underlying storage to allocate memory large
             ///        enough to hold at least 'size' (or more) elements. </summary>
             ///
             void reserve(size_t size);
 
             /// <summary> Trim unused empty slots after the last non-empty slot.
-            ///        Up to 4 are allowed to remain. </summary>
+            ///        Up to 4 are allowed to remain. Storage policies that can
+            ///        release memory without moving slots (see SlabStorage.hpp)
+            ///        hand the memory behind the trimmed slots back. </summary>
             ///
             void resize_to_min();
 
@@ -109,355 +469,1772 @@ namespace gen {
             ///
             void shrink_to_fit();
 
-            // STUB - Iterations
+            /// <summary> Defragment: move filled slots from the tail into the lowest
+            ///        empty slots until filled slots are packed at the front, then
+            ///        trim the tail as resize_to_min() does. fn(from, to) is called
+            ///        before each move so the caller can relocate its object; if
+            ///        it throws, that move is not made. Moved-from slots are given
+            ///        back, so their handles go stale. With SLAB_NO_FILLED_LIST
+            ///        the empty list is rebuilt from the bitmap afterwards. </summary>
+            ///
+            template <class Fn>
+            void compact(Fn fn);
 
-            // DEBUG METHODS:
-            /*
-            void debug_print() const;
+            /// <summary> Incremental compact(): make at most budget moves. Returns true
+            ///        (after trimming the tail) once the slots are packed. Not
+            ///        available with SLAB_NO_FILLED_LIST, where every step would
+            ///        have to rebuild the empty list. </summary>
+            ///
+            template <class Fn>
+            bool compact_step(size_t budget, Fn fn);
 
-            void debug_lists() const;
+            // ITERATIONS:
 
-            void debug_check_integrity() const;
-            */
+            /// <summary> Forward iterator following one of the manager's internal
+            ///        lists (filled or empty). Dereferences to a slot index. The
+            ///        slot it points to may be given back or acquired only after
+            ///        the iterator has been advanced past it. </summary>
+            ///
+            class ListIterator {
 
-        };
+                public:
 
-    // *** Implementation below: *** //
+                    typedef std::forward_iterator_tag iterator_category;
+                    typedef Index                     value_type;
+                    typedef std::ptrdiff_t            difference_type;
+                    typedef const Index *             pointer;
+                    typedef Index                     reference;
 
-    inline
-    SlabManager::SlabManager()
-        : elem_vec(1) {
-        
-        initialize(1);
+                    ListIterator()
+                        : mgr(nullptr)
+                        , cur(NULL_INDEX)
+                        { }
 
-        }
+                    Index operator*() const { return cur; }
 
-    inline
-    SlabManager::SlabManager(size_t n)
-        : elem_vec((n > 0) ? n : 1u) {
+                    ListIterator & operator++() { cur = mgr->next_vec[cur]; return *this; }
+                    ListIterator   operator++(int) { ListIterator rv = *this; ++(*this); return rv; }
 
-        n = ((n > 0) ? n : 1u);
+                    bool operator==(const ListIterator & other) const { return cur == other.cur; }
+                    bool operator!=(const ListIterator & other) const { return cur != other.cur; }
 
-        initialize(n);
+                private:
 
-        }
+                    friend class BasicSlabManager;
 
-    inline
-    void SlabManager::initialize(size_t n) {
+                    ListIterator(const BasicSlabManager * mgr, Index cur)
+                        : mgr(mgr)
+                        , cur(cur)
+                        { }
 
-        empty_head = 0;
-        filled_head = NULL_INDEX;
+                    const BasicSlabManager * mgr;
+                    Index cur;
 
-        if (n > 1) {
+                };
 
-            elem_vec[0].is_empty = true;
-            elem_vec[0].prev = NULL_INDEX;
-            elem_vec[0].next = Index(1);
+            /// <summary> Forward iterator over empty slots: first the empty list, then
+            ///        the slots past the high-water mark that were never touched.
+            ///        Same invalidation rules as ListIterator. </summary>
+            ///
+            class EmptyIterator {
 
-            for (size_t i = 1; i < n - 1; i += 1) {
+                public:
 
-                elem_vec[i].is_empty = true;
+                    typedef std::forward_iterator_tag iterator_category;
+                    typedef Index                     value_type;
+                    typedef std::ptrdiff_t            difference_type;
+                    typedef const Index *             pointer;
+                    typedef Index                     reference;
 
-                elem_vec[i].prev = Index(i - 1);
-                elem_vec[i].next = Index(i + 1);
+                    EmptyIterator()
+                        : mgr(nullptr)
+                        , cur(NULL_INDEX)
+                        { }
 
-                }
+                    Index operator*() const { return cur; }
 
-            elem_vec[n - 1].is_empty = true;
-            elem_vec[n - 1].prev = n - 2;
-            elem_vec[n - 1].next = NULL_INDEX;
+                    EmptyIterator & operator++() {
 
-            }
-        else { // Initialize with 1 slot
+                        size_t nxt;
 
-            elem_vec[0].is_empty = true;
-            elem_vec[0].prev = NULL_INDEX;
-            elem_vec[0].next = NULL_INDEX;
+                        if (cur < mgr->touched())
+                            nxt = (mgr->next_vec[cur] != NULL_INDEX) ? mgr->next_vec[cur] : mgr->touched();
+                        else
+                            nxt = size_t(cur) + 1;
 
-            empty_head  = 0;
-            filled_head = NULL_INDEX;
+                        cur = (nxt < mgr->slot_cnt) ? Index(nxt) : NULL_INDEX;
 
-            }
+                        return *this;
 
-         empty_cnt = n;
-        filled_cnt = 0;
+                        }
 
-        }
+                    EmptyIterator operator++(int) { EmptyIterator rv = *this; ++(*this); return rv; }
 
-    inline
-    SlabManager::Index SlabManager::acquire() {
-        
-        if (empty_head != NULL_INDEX) {
-            
-            auto rv = empty_head;
+                    bool operator==(const EmptyIterator & other) const { return cur == other.cur; }
+                    bool operator!=(const EmptyIterator & other) const { return cur != other.cur; }
 
-            // "Move" empty_head:
-            empty_head = elem_vec[empty_head].next;
-            if (empty_head != NULL_INDEX) {
-                
-                elem_vec[empty_head].prev = NULL_INDEX;
+                private:
 
-                }
+                    friend class BasicSlabManager;
 
-            // Link acquired element with filled ones:
-            if (filled_head != NULL_INDEX) {
-                
-                elem_vec[filled_head].prev = rv;
+                    EmptyIterator(const BasicSlabManager * mgr, Index cur)
+                        : mgr(mgr)
+                        , cur(cur)
+                        { }
 
-                }
-            elem_vec[rv].next = filled_head;
-            elem_vec[rv].prev = NULL_INDEX;
-            filled_head = rv;
+                    const BasicSlabManager * mgr;
+                    Index cur;
 
-            elem_vec[rv].is_empty = false;
+                };
 
-             empty_cnt -= 1;
-            filled_cnt += 1;
+            /// <summary> Forward iterator over filled slots in ascending index order,
+            ///        suitable for sequential access into a parallel storage array.
+            ///        Scans the occupancy bitmap a word at a time, so runs of 64
+            ///        empty slots are skipped in one step. Same invalidation
+            ///        rules as ListIterator. </summary>
+            ///
+            class OrderedIterator {
 
-            return rv;
+                public:
 
-            }
-        else {
-            
-            size_t rv = elem_vec.size();
+                    typedef std::forward_iterator_tag iterator_category;
+                    typedef Index                     value_type;
+                    typedef std::ptrdiff_t            difference_type;
+                    typedef const Index *             pointer;
+                    typedef Index                     reference;
 
-            elem_vec.push_back(Elem());
+                    OrderedIterator()
+                        : mgr(nullptr)
+                        , word(0)
+                        , bits(0)
+                        { }
 
-            // Link acquired element with filled ones:
-            if (filled_head != NULL_INDEX) {
+                    Index operator*() const { return Index(word * WORD_BITS + detail::ctz64(bits)); }
 
-                elem_vec[filled_head].prev = rv;
+                    OrderedIterator & operator++() { bits &= (bits - 1); seek(); return *this; }
+                    OrderedIterator   operator++(int) { OrderedIterator rv = *this; ++(*this); return rv; }
 
-                }
-            elem_vec[rv].next = filled_head;
-            elem_vec[rv].prev = NULL_INDEX;
-            filled_head = rv;
+                    bool operator==(const OrderedIterator & other) const { return word == other.word && bits == other.bits; }
+                    bool operator!=(const OrderedIterator & other) const { return !(*this == other); }
 
-            elem_vec[rv].is_empty = false;
+                private:
 
-            filled_cnt += 1;
+                    friend class BasicSlabManager;
 
-            return rv;
+                    // Position at the first filled slot in or after the given word:
+                    OrderedIterator(const BasicSlabManager * mgr, size_t word)
+                        : mgr(mgr)
+                        , word(word)
+                        , bits((word < mgr->occ_vec.size()) ? mgr->occ_vec[word] : 0)
+                        { seek(); }
 
-            }
+                    // Skip words with no filled slots; end is (occ_vec.size(), 0):
+                    void seek() {
 
-        }
+                        size_t wcnt = mgr->occ_vec.size();
 
-    inline
-    void SlabManager::give_back(Index ind) {
-        
-        if (is_slot_empty(ind)) throw std::logic_error("SlabManager::free - Element not acquired!");
+                        while (bits == 0 && word < wcnt) {
 
-        // Remove from list of filled elements:
-        auto prev = elem_vec[ind].prev;
-        auto next = elem_vec[ind].next;
+                            word += 1;
+                            bits  = (word < wcnt) ? mgr->occ_vec[word] : 0;
 
-        if (next != NULL_INDEX) 
-            elem_vec[next].prev = prev;
-        else 
-            { /* Do nothing */ }
+                            }
 
-        if (prev != NULL_INDEX) 
-            elem_vec[prev].next = next;
-        else
-            filled_head = next;
+                        }
 
-        // Link with empty elements:
-        if (empty_head != NULL_INDEX) {
+                    const BasicSlabManager * mgr;
+                    size_t word; // Current bitmap word
+                    Word   bits; // Filled slots of the current word not yet visited
 
-            elem_vec[empty_head].prev = ind;
+                };
 
-            }
-        elem_vec[ind].next = empty_head;
-        elem_vec[ind].prev = NULL_INDEX;
-        empty_head = ind;
+            /// <summary> Pair of iterators usable in range-for. </summary>
+            ///
+            template <class Iter>
+            class Range {
 
-        elem_vec[ind].is_empty = true;
+                public:
 
-        filled_cnt -= 1;
-         empty_cnt += 1;
+                    Range(Iter first, Iter last)
+                        : first(first)
+                        , last(last)
+                        { }
 
-        }
+                    Iter begin() const { return first; }
+                    Iter   end() const { return last;  }
 
-    inline
-    bool SlabManager::is_slot_empty(Index ind) const {
+                private:
 
-        if (ind >= elem_vec.size()) throw std::out_of_range("SlabManager::is_empty - Index out of bounds!");
+                    Iter first;
+                    Iter last;
 
-        return elem_vec[ind].is_empty;
+                };
 
-        }
+            /// <summary> Iterator type of begin() / filled_slots(): ListIterator, or
+            ///        OrderedIterator with SLAB_NO_FILLED_LIST. </summary>
+            ///
+            typedef typename std::conditional<NO_FILLED_LIST, OrderedIterator, ListIterator>::type FilledIterator;
+
+            /// <summary> Iterate over filled slots (most recently acquired first, or in
+            ///        ascending index order with SLAB_NO_FILLED_LIST). </summary>
+            ///
+            FilledIterator begin() const;
+            FilledIterator end() const;
+
+            /// <summary> Range of filled slots (most recently acquired first, or in
+            ///        ascending index order with SLAB_NO_FILLED_LIST). </summary>
+            ///
+            Range<FilledIterator> filled_slots() const;
+
+            /// <summary> Range of empty slots, in the order acquire() would hand them out
+            ///        (in no particular order with SLAB_LOWEST_FIRST). </summary>
+            ///
+            Range<EmptyIterator> empty_slots() const;
+
+            /// <summary> Range of filled slots in ascending index order. </summary>
+            ///
+            Range<OrderedIterator> filled_slots_ordered() const;
+
+            /// <summary> Call fn(index) for every filled slot in ascending index order.
+            ///        Cheaper than filled_slots_ordered() in tight loops. fn may
+            ///        give back the slot it is called with. </summary>
+            ///
+            template <class Fn>
+            void for_each_filled(Fn fn) const;
+
+        private:
+
+            Range<ListIterator>    filled_range(std::false_type) const;
+            Range<OrderedIterator> filled_range(std::true_type) const;
 
+            // DEBUG METHODS:
+            /*
+            void debug_print() const;
+
+            void debug_lists() const;
+
+            void debug_check_integrity() const;
+            */
+
+        };
+
+    /// <summary> Slab manager with size_t indices. </summary>
+    ///
+    typedef BasicSlabManager<size_t> SlabManager;
+
+    // *** Implementation below: *** //
+
+    template <class IndexT, unsigned Options, class Storage>
     inline
-    void SlabManager::clear() {
+    BasicSlabManager<IndexT, Options, Storage>::BasicSlabManager()
+        : limit_cnt(max_size()) {
         
-        initialize( elem_vec.size() );
+        initialize(1);
 
         }
 
+    template <class IndexT, unsigned Options, class Storage>
     inline
-    size_t SlabManager::size() const {
+    BasicSlabManager<IndexT, Options, Storage>::BasicSlabManager(size_t n)
+        : limit_cnt(max_size()) {
+
+        n = checked_size(n);
 
-        return elem_vec.size();
+        reserve(n);
+
+        initialize(n);
 
         }
 
+    template <class IndexT, unsigned Options, class Storage>
     inline
-    size_t SlabManager::capacity() const {
+    size_t BasicSlabManager<IndexT, Options, Storage>::checked_size(size_t n) {
 
-        return elem_vec.capacity();
+        if (n > max_size()) GEN_SLAB_THROW(std::length_error("SlabManager - Size exceeds the range of Index!"));
+
+        return ((n > 0) ? n : 1u);
 
         }
 
+    template <class IndexT, unsigned Options, class Storage>
     inline
-    size_t SlabManager::empty_count() const {
-        
-        return empty_cnt;
+    bool BasicSlabManager<IndexT, Options, Storage>::can_grow(size_t base, size_t n) const {
 
-        }
+        // Checks that slots [0, base + n) are within size() or size_limit():
+        return (n <= slot_cnt - base) || (base <= limit_cnt && n <= limit_cnt - base);
 
-    inline
-    size_t SlabManager::filled_count() const {
-        
-        return filled_cnt;
-        
         }
 
+    template <class IndexT, unsigned Options, class Storage>
     inline
-    void SlabManager::resize(size_t newsize) {
-        
-        size_t ss = elem_vec.size();
-
-        if (ss == newsize) return;
+    size_t BasicSlabManager<IndexT, Options, Storage>::words_for(size_t n) {
 
-        if (newsize > ss) { // Upsize
-            
-            elem_vec.resize(newsize);
+        return (n + WORD_BITS - 1) / WORD_BITS;
 
-            for (size_t i = ss; i < newsize; i += 1) {
-                
-                // elem_vec[i].is_empty = true; - Not needed 'cause freshly initialized
+        }
 
-                elem_vec[i].prev = NULL_INDEX;
-                elem_vec[i].next = empty_head;
+    template <class IndexT, unsigned Options, class Storage>
+    inline
+    bool BasicSlabManager<IndexT, Options, Storage>::test_bit(size_t ind) const {
 
-                if (empty_head != NULL_INDEX) elem_vec[empty_head].prev = i;
+        return ((occ_vec[ind / WORD_BITS] >> (ind % WORD_BITS)) & 1u) != 0;
 
-                empty_head = i;
+        }
 
-                }
+    template <class IndexT, unsigned Options, class Storage>
+    inline
+    void BasicSlabManager<IndexT, Options, Storage>::set_bit(size_t ind) {
 
-            empty_cnt += (newsize - ss);
+        size_t w = ind / WORD_BITS;
 
-            }
-        else { // Downsize
-            
-            size_t pos = NULL_INDEX;
-            size_t cnt = 0;
+        occ_vec[w] |= (Word(1) << (ind % WORD_BITS));
 
-            newsize = ((newsize > 0) ? newsize : 1l);
+        if (ind >= filled_end) filled_end = ind + 1;
 
-            for (size_t i = ss - 1; true; i -= 1) {
-                
-                if (elem_vec[i].is_empty == false) { pos = i; break; }
+        if (LOWEST_FIRST && occ_vec[w] == ~Word(0)) {
 
-                cnt += 1;
+            // The word filled up - propagate up while summary words fill too:
+            for (size_t k = 0, lw = w; k < full_depth; k += 1) {
 
-                // ***
-                if (i == 0) break;
+                size_t up = lw / WORD_BITS;
 
-                }
+                full_lvl[k][up] |= (Word(1) << (lw % WORD_BITS));
 
-            if (pos == NULL_INDEX) {
-                
-                elem_vec.resize(newsize);
+                if (full_lvl[k][up] != ~Word(0)) break;
 
-                initialize( elem_vec.size() );
+                lw = up;
 
                 }
-            else {
-
-                if (pos == ss - 1) return;
 
-                if (empty_cnt - cnt < 4u) return;
-                
-                if (newsize > pos + 1)
-                    elem_vec.resize(newsize);
-                else
-                    elem_vec.resize(pos + 1);
-
-                // Relink empties:
-                empty_head = NULL_INDEX;
-                empty_cnt  = 0;
-                for (size_t i = elem_vec.size() - 1; true; i -= 1) {
-                    
-                    if (elem_vec[i].is_empty == true) {
-                        
-                        empty_cnt += 1;
-
-                        if (empty_head == NULL_INDEX) {
+            }
 
-                            elem_vec[i].prev = NULL_INDEX;
-                            elem_vec[i].next = NULL_INDEX;
+        }
 
-                            empty_head = i;
+    template <class IndexT, unsigned Options, class Storage>
+    inline
+    void BasicSlabManager<IndexT, Options, Storage>::clear_bit(size_t ind) {
 
-                            }
-                        else {
+        size_t w = ind / WORD_BITS;
 
-                            elem_vec[empty_head].prev = i;
+        if (LOWEST_FIRST && occ_vec[w] == ~Word(0)) {
 
-                            elem_vec[i].prev = NULL_INDEX;
-                            elem_vec[i].next = empty_head;
+            // The word stops being full - propagate up while summary words were full:
+            for (size_t k = 0, lw = w; k < full_depth; k += 1) {
 
-                            empty_head = i;
-                            
-                            }
+                size_t up  = lw / WORD_BITS;
+                bool   was = (full_lvl[k][up] == ~Word(0));
 
-                        }
+                full_lvl[k][up] &= ~(Word(1) << (lw % WORD_BITS));
 
-                    // End condition:
-                    if (i == 0) break;
+                if (!was) break;
 
-                    }
+                lw = up;
 
                 }
 
             }
-        
-        }
-
-    inline
-    void SlabManager::reserve(size_t size) {
 
-        elem_vec.reserve(size);
+        occ_vec[w] &= ~(Word(1) << (ind % WORD_BITS));
 
         }
 
+    template <class IndexT, unsigned Options, class Storage>
     inline
-    void SlabManager::resize_to_min() {
+    void BasicSlabManager<IndexT, Options, Storage>::resize_words(size_t wcnt) {
 
-        resize(1u);
+        occ_vec.resize(wcnt);
+
+        if (!LOWEST_FIRST) return;
+
+        // Words past the old end are empty, so their summary bits are clear.
+        // A level added on top covers existing words, so its only word is
+        // set from the one below:
+        size_t cnt = wcnt;
+        size_t k   = 0;
+
+        do {
+
+            cnt = words_for(cnt);
+
+            bool added = (full_lvl[k].size() == 0 && k > 0);
+
+            full_lvl[k].resize(cnt);
+
+            if (added && cnt > 0 && full_lvl[k - 1][0] == ~Word(0)) full_lvl[k][0] = Word(1);
+
+            k += 1;
+
+            } while (cnt > 1);
+
+        full_depth = k;
+
+        // Levels no longer needed after a downsize:
+        for (; k < FULL_LEVELS; k += 1) full_lvl[k].clear();
+
+        }
+
+    template <class IndexT, unsigned Options, class Storage>
+    inline
+    size_t BasicSlabManager<IndexT, Options, Storage>::lowest_empty() const {
+
+        // Only called while the empty list is non-empty, so there is a
+        // touched empty slot. Descend from the single top word:
+        size_t w = 0;
+
+        for (size_t k = full_depth; k > 0; k -= 1) w = w * WORD_BITS + detail::ctz64(~full_lvl[k - 1][w]);
+
+        return w * WORD_BITS + detail::ctz64(~occ_vec[w]);
+
+        }
+
+    template <class IndexT, unsigned Options, class Storage>
+    inline
+    void BasicSlabManager<IndexT, Options, Storage>::initialize(size_t n) {
+
+        // Forget every touched slot; the arrays keep their memory:
+        occ_vec.clear();
+        prev_vec.clear();
+        next_vec.clear();
+
+        for (auto & lvl : full_lvl) lvl.clear();
+
+        full_depth = 0;
+
+         empty_head = NULL_INDEX;
+        filled_head = NULL_INDEX;
+
+        slot_cnt   = n;
+        filled_end = 0;
+
+         empty_cnt = n;
+        filled_cnt = 0;
+
+        }
+
+    template <class IndexT, unsigned Options, class Storage>
+    inline
+    size_t BasicSlabManager<IndexT, Options, Storage>::touched() const {
+
+        return next_vec.size();
+
+        }
+
+    template <class IndexT, unsigned Options, class Storage>
+    inline
+    typename BasicSlabManager<IndexT, Options, Storage>::Index BasicSlabManager<IndexT, Options, Storage>::touch_filled() {
+
+        // Bump the high-water mark and link the new slot with filled ones:
+        Index rv = Index(next_vec.size());
+
+        if (rv % WORD_BITS == 0) resize_words(occ_vec.size() + 1);
+
+        if (NO_FILLED_LIST)
+            next_vec.push_back(Index(NULL_INDEX));
+        else {
+
+            prev_vec.push_back(Index(NULL_INDEX));
+            next_vec.push_back(filled_head);
+
+            if (filled_head != NULL_INDEX) prev_vec[filled_head] = rv;
+
+            filled_head = rv;
+
+            }
+
+        set_bit(rv);
+
+        touch_generation(rv);
+
+        return rv;
+
+        }
+
+    template <class IndexT, unsigned Options, class Storage>
+    inline
+    void BasicSlabManager<IndexT, Options, Storage>::touch_generation(size_t ind) {
+
+        if (!HAS_GENERATIONS) return;
+
+        // A slot touched before (and since forgotten by clear() or trimming)
+        // moves on to a new generation; a brand new slot starts at zero:
+        if (ind < gen_vec.size())
+            gen_vec[ind] += 1;
+        else
+            gen_vec.push_back(0);
+
+        }
+
+    template <class IndexT, unsigned Options, class Storage>
+    inline
+    size_t BasicSlabManager<IndexT, Options, Storage>::last_filled() const {
+
+        return prev_set(filled_end);
+
+        }
+
+    template <class IndexT, unsigned Options, class Storage>
+    inline
+    size_t BasicSlabManager<IndexT, Options, Storage>::prev_set(size_t pos) const {
+
+        // Last filled slot below pos (pos <= touched()), or size_t(-1):
+        if (pos == 0) return size_t(-1);
+
+        size_t w    = (pos - 1) / WORD_BITS;
+        Word   bits = occ_vec[w] & (~Word(0) >> (WORD_BITS - 1 - (pos - 1) % WORD_BITS));
+
+        while (bits == 0) {
+
+            if (w == 0) return size_t(-1);
+
+            w   -= 1;
+            bits = occ_vec[w];
+
+            }
+
+        return w * WORD_BITS + detail::bsr64(bits);
+
+        }
+
+    template <class IndexT, unsigned Options, class Storage>
+    inline
+    void BasicSlabManager<IndexT, Options, Storage>::touch_empty() {
+
+        // Bump the high-water mark and link the new slot with empty ones:
+        Index ind = Index(next_vec.size());
+
+        if (ind % WORD_BITS == 0) resize_words(occ_vec.size() + 1);
+
+        next_vec.push_back(empty_head);
+
+        if (!NO_FILLED_LIST) {
+
+            prev_vec.push_back(Index(NULL_INDEX));
+
+            if (empty_head != NULL_INDEX) prev_vec[empty_head] = ind;
+
+            }
+
+        empty_head = ind;
+
+        touch_generation(ind);
+
+        }
+
+    template <class IndexT, unsigned Options, class Storage>
+    inline
+    void BasicSlabManager<IndexT, Options, Storage>::unlink_empty(Index ind) {
+
+        auto prev = prev_vec[ind];
+        auto next = next_vec[ind];
+
+        if (next != NULL_INDEX) prev_vec[next] = prev;
+
+        if (prev != NULL_INDEX)
+            next_vec[prev] = next;
+        else
+            empty_head = next;
+
+        }
+
+    template <class IndexT, unsigned Options, class Storage>
+    inline
+    void BasicSlabManager<IndexT, Options, Storage>::take_empty(Index ind) {
+
+        if (NO_FILLED_LIST) {
+
+            // Only the head can be taken from the singly linked empty list:
+            assert(ind == empty_head && "SlabManager::take_empty - Not the head of the empty list!");
+
+            empty_head = next_vec[ind];
+
+            }
+        else {
+
+            unlink_empty(ind);
+
+            // Link acquired element with filled ones:
+            if (filled_head != NULL_INDEX) {
+                
+                prev_vec[filled_head] = ind;
+
+                }
+            next_vec[ind] = filled_head;
+            prev_vec[ind] = NULL_INDEX;
+            filled_head = ind;
+
+            }
+
+        set_bit(ind);
+
+         empty_cnt -= 1;
+        filled_cnt += 1;
+
+        }
+
+    template <class IndexT, unsigned Options, class Storage>
+    inline
+    void BasicSlabManager<IndexT, Options, Storage>::unlink_tail(size_t from) {
+
+        // Unlink the empty slots [from, touched()) from the empty list:
+        if (!NO_FILLED_LIST) {
+
+            for (size_t i = from; i < touched(); i += 1) unlink_empty(Index(i));
+
+            return;
+
+            }
+
+        // A singly linked list cannot unlink from the middle - walk it from the
+        // head and splice the slots out until all are found. They were usually
+        // given back last, so they sit near the head:
+        size_t left = touched() - from;
+
+        Index prev = Index(NULL_INDEX);
+        Index cur  = empty_head;
+
+        while (left > 0) {
+
+            Index next = next_vec[cur];
+
+            if (size_t(cur) >= from) {
+
+                if (prev != NULL_INDEX)
+                    next_vec[prev] = next;
+                else
+                    empty_head = next;
+
+                left -= 1;
+
+                }
+            else
+                prev = cur;
+
+            cur = next;
+
+            }
+
+        }
+
+    template <class IndexT, unsigned Options, class Storage>
+    inline
+    void BasicSlabManager<IndexT, Options, Storage>::relink_empty() {
+
+        // Rebuild the empty list from the bitmap (SLAB_NO_FILLED_LIST compact(),
+        // which fills holes in the middle of the list). Pushed from the top
+        // down, so the list hands slots out in ascending order:
+        size_t tt = touched();
+
+        empty_head = NULL_INDEX;
+
+        for (size_t w = words_for(tt); w > 0; w -= 1) {
+
+            Word bits = ~occ_vec[w - 1];
+
+            if (w * WORD_BITS > tt) bits &= (Word(1) << (tt % WORD_BITS)) - 1;
+
+            while (bits != 0) {
+
+                size_t b = detail::bsr64(bits);
+
+                next_vec[(w - 1) * WORD_BITS + b] = empty_head;
+                empty_head = Index((w - 1) * WORD_BITS + b);
+
+                bits &= ~(Word(1) << b);
+
+                }
+
+            }
+
+        }
+
+    template <class IndexT, unsigned Options, class Storage>
+    inline
+    typename BasicSlabManager<IndexT, Options, Storage>::Index BasicSlabManager<IndexT, Options, Storage>::acquire() {
+        
+        if (empty_head != NULL_INDEX) {
+            
+            // Take the head of the empty list (the lowest slot with LOWEST_FIRST):
+            auto rv = (LOWEST_FIRST) ? Index(lowest_empty()) : empty_head;
+
+            take_empty(rv);
+
+            return rv;
+
+            }
+        else {
+            
+            if (touched() == slot_cnt) { // Grow by one
+
+                if (slot_cnt >= limit_cnt) GEN_SLAB_THROW(std::length_error("SlabManager::acquire - Size limit reached!"));
+
+                slot_cnt  += 1;
+                empty_cnt += 1;
+
+                }
+
+            Index rv = touch_filled();
+
+             empty_cnt -= 1;
+            filled_cnt += 1;
+
+            return rv;
+
+            }
+
+        }
+
+#if defined(GEN_SLAB_HAS_OPTIONAL)
+    template <class IndexT, unsigned Options, class Storage>
+    inline
+    std::optional<typename BasicSlabManager<IndexT, Options, Storage>::Index> BasicSlabManager<IndexT, Options, Storage>::try_acquire() {
+
+        if (at_limit()) return std::nullopt;
+
+        return acquire();
+
+        }
+#endif
+
+    template <class IndexT, unsigned Options, class Storage>
+    inline
+    SlabStatus BasicSlabManager<IndexT, Options, Storage>::try_acquire(Index & out) {
+
+        if (at_limit()) return SLAB_LIMIT_REACHED;
+
+        out = acquire();
+
+        return SLAB_OK;
+
+        }
+
+    template <class IndexT, unsigned Options, class Storage>
+    inline
+    bool BasicSlabManager<IndexT, Options, Storage>::at_limit() const {
+
+        // No empty slot left and no room to grow - acquire() would throw:
+        return (empty_head == NULL_INDEX && touched() == slot_cnt && slot_cnt >= limit_cnt);
+
+        }
+
+    template <class IndexT, unsigned Options, class Storage>
+    inline
+    size_t BasicSlabManager<IndexT, Options, Storage>::find_near(size_t hint) const {
+
+        // Candidates are empty slots below slot_cnt; untouched ones only
+        // close enough to the mark that touching up to them stays bounded:
+        size_t tt  = touched();
+        size_t lim = (slot_cnt - tt > (2 * NEAR_WORDS + 1) * WORD_BITS) ? tt + (2 * NEAR_WORDS + 1) * WORD_BITS : slot_cnt;
+
+        size_t hw = hint / WORD_BITS;
+        size_t hb = hint % WORD_BITS;
+
+        size_t rv   = size_t(-1);
+        size_t dist = size_t(-1);
+
+        for (size_t d = 0; d <= NEAR_WORDS && rv == size_t(-1); d += 1) {
+
+            for (int side = 0; side < 2; side += 1) {
+
+                if (side == 1 && (d == 0 || d > hw)) continue;
+
+                size_t w = (side == 0) ? hw + d : hw - d;
+
+                if (w * WORD_BITS >= lim) continue;
+
+                // Empty slots of the word that are below lim:
+                Word empties = ~((w < occ_vec.size()) ? occ_vec[w] : Word(0));
+
+                if (lim - w * WORD_BITS < WORD_BITS) empties &= (Word(1) << (lim - w * WORD_BITS)) - 1;
+
+                if (empties == 0) continue;
+
+                size_t pos;
+
+                if (d > 0) // Nearest to the hint: lowest bit above, highest bit below
+                    pos = w * WORD_BITS + ((side == 0) ? detail::ctz64(empties) : detail::bsr64(empties));
+                else {
+
+                    Word above = empties >> hb;
+                    Word below = empties & ((Word(1) << hb) - 1);
+
+                    size_t up   = (above != 0) ? hint + detail::ctz64(above) : size_t(-1);
+                    size_t down = (below != 0) ? w * WORD_BITS + detail::bsr64(below) : size_t(-1);
+
+                    pos = (down != size_t(-1) && (up == size_t(-1) || hint - down < up - hint)) ? down : up;
+
+                    }
+
+                size_t pd = (pos > hint) ? pos - hint : hint - pos;
+
+                if (pd < dist) { rv = pos; dist = pd; }
+
+                }
+
+            }
+
+        return rv;
+
+        }
+
+    template <class IndexT, unsigned Options, class Storage>
+    inline
+    typename BasicSlabManager<IndexT, Options, Storage>::Index BasicSlabManager<IndexT, Options, Storage>::acquire_near(Index hint) {
+
+        static_assert(!NO_FILLED_LIST, "SlabManager::acquire_near - Not available with SLAB_NO_FILLED_LIST!");
+
+        if (hint >= slot_cnt) GEN_SLAB_THROW(std::out_of_range("SlabManager::acquire_near - Index out of bounds!"));
+
+        size_t pos = find_near(hint);
+
+        if (pos == size_t(-1)) return acquire();
+
+        // Touch untouched slots up to pos, they join the empty list:
+        while (touched() <= pos) touch_empty();
+
+        take_empty(Index(pos));
+
+        return Index(pos);
+
+        }
+
+    template <class IndexT, unsigned Options, class Storage>
+    inline
+    SlabStatus BasicSlabManager<IndexT, Options, Storage>::try_acquire_near(Index hint, Index & out) {
+
+        if (hint >= slot_cnt) return SLAB_OUT_OF_BOUNDS;
+
+        // The search only fails when acquire() has to grow:
+        if (at_limit()) return SLAB_LIMIT_REACHED;
+
+        out = acquire_near(hint);
+
+        return SLAB_OK;
+
+        }
+
+    template <class IndexT, unsigned Options, class Storage>
+    inline
+    size_t BasicSlabManager<IndexT, Options, Storage>::next_set(size_t pos, size_t end) const {
+
+        // First filled slot in [pos, end), or end; end <= touched():
+        if (pos >= end) return end;
+
+        size_t w    = pos / WORD_BITS;
+        Word   bits = occ_vec[w] & (~Word(0) << (pos % WORD_BITS));
+
+        while (bits == 0) {
+
+            w += 1;
+
+            if (w * WORD_BITS >= end) return end;
+
+            bits = occ_vec[w];
+
+            }
+
+        size_t rv = w * WORD_BITS + detail::ctz64(bits);
+
+        return (rv < end) ? rv : end;
+
+        }
+
+    template <class IndexT, unsigned Options, class Storage>
+    inline
+    size_t BasicSlabManager<IndexT, Options, Storage>::next_clear(size_t pos, size_t end) const {
+
+        // First empty slot in [pos, end), or end; end <= touched():
+        if (pos >= end) return end;
+
+        size_t w    = pos / WORD_BITS;
+        Word   bits = ~occ_vec[w] & (~Word(0) << (pos % WORD_BITS));
+
+        while (bits == 0) {
+
+            w += 1;
+
+            if (w * WORD_BITS >= end) return end;
+
+            bits = ~occ_vec[w];
+
+            }
+
+        size_t rv = w * WORD_BITS + detail::ctz64(bits);
+
+        return (rv < end) ? rv : end;
+
+        }
+
+    template <class IndexT, unsigned Options, class Storage>
+    inline
+    size_t BasicSlabManager<IndexT, Options, Storage>::find_range(size_t n, Fit fit) const {
+
+        size_t tt = touched();
+
+        size_t best     = size_t(-1);
+        size_t best_len = size_t(-1);
+
+        // Runs of empty slots below the high-water mark; a run reaching the
+        // mark continues into the untouched slots and is handled below:
+        size_t pos = next_clear(0, tt);
+
+        while (pos < tt) {
+
+            size_t run_end = next_set(pos, tt);
+
+            if (run_end == tt) break;
+
+            size_t len = run_end - pos;
+
+            if (len >= n && len < best_len) {
+
+                best     = pos;
+                best_len = len;
+
+                if (fit == FIRST_FIT || len == n) return best;
+
+                }
+
+            pos = next_clear(run_end, tt);
+
+            }
+
+        // Trailing run [pos, slot_cnt), which may be extended by growing:
+        if (best != size_t(-1) && (slot_cnt - pos < n || slot_cnt - pos >= best_len)) return best;
+
+        return pos;
+
+        }
+
+    template <class IndexT, unsigned Options, class Storage>
+    inline
+    typename BasicSlabManager<IndexT, Options, Storage>::Index BasicSlabManager<IndexT, Options, Storage>::acquire_range(size_t n, Fit fit) {
+
+        static_assert(!NO_FILLED_LIST, "SlabManager::acquire_range - Not available with SLAB_NO_FILLED_LIST!");
+
+        if (n == 0) GEN_SLAB_THROW(std::invalid_argument("SlabManager::acquire_range - Empty range!"));
+
+        size_t first = find_range(n, fit);
+
+        if (!can_grow(first, n)) GEN_SLAB_THROW(std::length_error("SlabManager::acquire_range - Size limit reached!"));
+
+        take_range(first, n);
+
+        return Index(first);
+
+        }
+
+    template <class IndexT, unsigned Options, class Storage>
+    inline
+    SlabStatus BasicSlabManager<IndexT, Options, Storage>::try_acquire_range(size_t n, Index & out, Fit fit) {
+
+        static_assert(!NO_FILLED_LIST, "SlabManager::try_acquire_range - Not available with SLAB_NO_FILLED_LIST!");
+
+        if (n == 0) return SLAB_EMPTY_RANGE;
+
+        size_t first = find_range(n, fit);
+
+        if (!can_grow(first, n)) return SLAB_LIMIT_REACHED;
+
+        take_range(first, n);
+
+        out = Index(first);
+
+        return SLAB_OK;
+
+        }
+
+    template <class IndexT, unsigned Options, class Storage>
+    inline
+    void BasicSlabManager<IndexT, Options, Storage>::take_range(size_t first, size_t n) {
+
+        if (first + n > slot_cnt) { // Grow by the shortfall
+
+            reserve(first + n);
+
+            empty_cnt += (first + n - slot_cnt);
+            slot_cnt   = first + n;
+
+            }
+
+        // Touch the run's untouched slots, then move all of it to the filled list:
+        while (touched() < first + n) touch_empty();
+
+        for (size_t i = first; i < first + n; i += 1) take_empty(Index(i));
+
+        }
+
+    template <class IndexT, unsigned Options, class Storage>
+    inline
+    void BasicSlabManager<IndexT, Options, Storage>::give_back_range(Index first, size_t n) {
+
+        SlabStatus st = check_range(first, n);
+
+        if (st == SLAB_OUT_OF_BOUNDS) GEN_SLAB_THROW(std::out_of_range("SlabManager::give_back_range - Index out of bounds!"));
+        if (st == SLAB_NOT_ACQUIRED)  GEN_SLAB_THROW(std::logic_error("SlabManager::give_back_range - Element not acquired!"));
+
+        // Backwards, so that the empty list hands the run out in ascending order:
+        for (size_t i = first + n; i > first; i -= 1) give_back_unchecked(Index(i - 1));
+
+        }
+
+    template <class IndexT, unsigned Options, class Storage>
+    inline
+    SlabStatus BasicSlabManager<IndexT, Options, Storage>::try_give_back_range(Index first, size_t n) noexcept {
+
+        SlabStatus st = check_range(first, n);
+
+        if (st != SLAB_OK) return st;
+
+        for (size_t i = first + n; i > first; i -= 1) give_back_unchecked(Index(i - 1));
+
+        return SLAB_OK;
+
+        }
+
+    template <class IndexT, unsigned Options, class Storage>
+    inline
+    SlabStatus BasicSlabManager<IndexT, Options, Storage>::check_range(Index first, size_t n) const {
+
+        if (n == 0) return SLAB_OK;
+
+        if (first >= slot_cnt || n > slot_cnt - first) return SLAB_OUT_OF_BOUNDS;
+
+        if (first + n > touched() || next_clear(first, first + n) != first + n) return SLAB_NOT_ACQUIRED;
+
+        return SLAB_OK;
+
+        }
+
+    template <class IndexT, unsigned Options, class Storage>
+    inline
+    void BasicSlabManager<IndexT, Options, Storage>::give_back(Index ind) {
+        
+        if (is_slot_empty(ind)) GEN_SLAB_THROW(std::logic_error("SlabManager::free - Element not acquired!"));
+
+        give_back_unchecked(ind);
+
+        }
+
+    template <class IndexT, unsigned Options, class Storage>
+    inline
+    SlabStatus BasicSlabManager<IndexT, Options, Storage>::try_give_back(Index ind) noexcept {
+
+        if (ind >= slot_cnt) return SLAB_OUT_OF_BOUNDS;
+
+        if (is_slot_empty_unchecked(ind)) return SLAB_NOT_ACQUIRED;
+
+        give_back_unchecked(ind);
+
+        return SLAB_OK;
+
+        }
+
+    template <class IndexT, unsigned Options, class Storage>
+    inline
+    void BasicSlabManager<IndexT, Options, Storage>::give_back_unchecked(Index ind) noexcept {
+
+        assert(!is_slot_empty_unchecked(ind) && "SlabManager::give_back_unchecked - Element not acquired!");
+
+        if (NO_FILLED_LIST) {
+
+            // Push onto the singly linked empty list, nothing to unlink:
+            next_vec[ind] = empty_head;
+            empty_head = ind;
+
+            }
+        else {
+
+            // Remove from list of filled elements:
+            auto prev = prev_vec[ind];
+            auto next = next_vec[ind];
+
+            if (next != NULL_INDEX) 
+                prev_vec[next] = prev;
+            else 
+                { /* Do nothing */ }
+
+            if (prev != NULL_INDEX) 
+                next_vec[prev] = next;
+            else
+                filled_head = next;
+
+            // Link with empty elements:
+            if (empty_head != NULL_INDEX) {
+
+                prev_vec[empty_head] = ind;
+
+                }
+            next_vec[ind] = empty_head;
+            prev_vec[ind] = NULL_INDEX;
+            empty_head = ind;
+
+            }
+
+        clear_bit(ind);
+
+        if (HAS_GENERATIONS) gen_vec[ind] += 1;
+
+        filled_cnt -= 1;
+         empty_cnt += 1;
+
+        }
+
+    template <class IndexT, unsigned Options, class Storage>
+    template <class OutputIt>
+    inline
+    OutputIt BasicSlabManager<IndexT, Options, Storage>::acquire_n(size_t n, OutputIt out) {
+
+        if (n == 0) return out;
+
+        size_t tt = touched();
+        size_t k  = (n < empty_cnt - (slot_cnt - tt)) ? n : empty_cnt - (slot_cnt - tt); // Taken from the empty list
+        size_t m  = n - k;                                                             // Touched past the mark
+
+        if (!can_grow(tt, m)) GEN_SLAB_THROW(std::length_error("SlabManager::acquire_n - Size limit reached!"));
+
+        if (LOWEST_FIRST) {
+
+            // Slots are picked one by one, lowest first; grow once up front:
+            if (tt + m > slot_cnt) resize(tt + m);
+
+            for (size_t i = 0; i < n; i += 1) {
+
+                *out = acquire();
+                ++out;
+
+                }
+
+            return out;
+
+            }
+
+        if (k > 0) {
+
+            // The first k empty slots already form a linked run - mark them
+            // and splice the whole run onto the front of the filled list:
+            Index first = empty_head;
+            Index last  = empty_head;
+
+            for (size_t i = 0; true; i += 1) {
+
+                set_bit(last);
+
+                *out = last;
+                ++out;
+
+                if (i == k - 1) break;
+
+                last = next_vec[last];
+
+                }
+
+            empty_head = next_vec[last];
+
+            if (!NO_FILLED_LIST) {
+
+                if (empty_head != NULL_INDEX) prev_vec[empty_head] = NULL_INDEX;
+
+                next_vec[last] = filled_head;
+                if (filled_head != NULL_INDEX) prev_vec[filled_head] = last;
+
+                filled_head = first;
+
+                }
+
+            }
+
+        if (m > 0) {
+
+            if (tt + m > slot_cnt) { // Grow by the shortfall
+
+                empty_cnt += (tt + m - slot_cnt);
+                slot_cnt   = tt + m;
+
+                }
+
+            resize_words(words_for(tt + m));
+            if (!NO_FILLED_LIST) prev_vec.resize(tt + m);
+            next_vec.resize(tt + m);
+
+            for (size_t i = tt; i < tt + m; i += 1) {
+
+                if (!NO_FILLED_LIST) {
+
+                    if (filled_head != NULL_INDEX) prev_vec[filled_head] = Index(i);
+
+                    next_vec[i] = filled_head;
+                    prev_vec[i] = NULL_INDEX;
+                    filled_head = Index(i);
+
+                    }
+
+                set_bit(i);
+
+                touch_generation(i);
+
+                *out = Index(i);
+                ++out;
+
+                }
+
+            }
+
+         empty_cnt -= n;
+        filled_cnt += n;
+
+        return out;
+
+        }
+
+    template <class IndexT, unsigned Options, class Storage>
+    template <class OutputIt>
+    inline
+    SlabStatus BasicSlabManager<IndexT, Options, Storage>::try_acquire_n(size_t n, OutputIt out) {
+
+        // Slots beyond those in the empty list are touched past the mark:
+        size_t tt     = touched();
+        size_t listed = empty_cnt - (slot_cnt - tt);
+
+        if (n > listed && !can_grow(tt, n - listed)) return SLAB_LIMIT_REACHED;
+
+        acquire_n(n, out);
+
+        return SLAB_OK;
+
+        }
+
+    template <class IndexT, unsigned Options, class Storage>
+    template <class ForwardIt>
+    inline
+    void BasicSlabManager<IndexT, Options, Storage>::give_back_n(ForwardIt first, ForwardIt last) {
+
+        SlabStatus st = release_n(first, last);
+
+        if (st == SLAB_OUT_OF_BOUNDS) GEN_SLAB_THROW(std::out_of_range("SlabManager::give_back_n - Index out of bounds!"));
+        if (st == SLAB_NOT_ACQUIRED)  GEN_SLAB_THROW(std::logic_error("SlabManager::give_back_n - Element not acquired!"));
+
+        }
+
+    template <class IndexT, unsigned Options, class Storage>
+    template <class ForwardIt>
+    inline
+    SlabStatus BasicSlabManager<IndexT, Options, Storage>::try_give_back_n(ForwardIt first, ForwardIt last) {
+
+        return release_n(first, last);
+
+        }
+
+    template <class IndexT, unsigned Options, class Storage>
+    template <class ForwardIt>
+    inline
+    SlabStatus BasicSlabManager<IndexT, Options, Storage>::release_n(ForwardIt first, ForwardIt last) {
+
+        size_t cnt = 0;
+
+        // Validate while clearing occupancy bits, so that a slot repeated
+        // within the batch is caught as well; undo everything on failure:
+        for (ForwardIt it = first; it != last; ++it) {
+
+            Index ind = *it;
+
+            if (ind >= touched() || test_bit(ind) == false) {
+
+                for (ForwardIt jt = first; jt != it; ++jt) set_bit(*jt);
+
+                return (ind >= slot_cnt) ? SLAB_OUT_OF_BOUNDS : SLAB_NOT_ACQUIRED;
+
+                }
+
+            clear_bit(ind);
+
+            cnt += 1;
+
+            }
+
+        for (ForwardIt it = first; it != last; ++it) {
+
+            Index ind = *it;
+
+            if (!NO_FILLED_LIST) {
+
+                // Remove from list of filled elements:
+                auto prev = prev_vec[ind];
+                auto next = next_vec[ind];
+
+                if (next != NULL_INDEX) prev_vec[next] = prev;
+
+                if (prev != NULL_INDEX)
+                    next_vec[prev] = next;
+                else
+                    filled_head = next;
+
+                if (empty_head != NULL_INDEX) prev_vec[empty_head] = ind;
+
+                prev_vec[ind] = NULL_INDEX;
+
+                }
+
+            // Link with empty elements:
+            next_vec[ind] = empty_head;
+            empty_head = ind;
+
+            if (HAS_GENERATIONS) gen_vec[ind] += 1;
+
+            }
+
+        filled_cnt -= cnt;
+         empty_cnt += cnt;
+
+        return SLAB_OK;
+
+        }
+
+    template <class IndexT, unsigned Options, class Storage>
+    inline
+    bool BasicSlabManager<IndexT, Options, Storage>::is_slot_empty(Index ind) const {
+
+        if (ind >= slot_cnt) GEN_SLAB_THROW(std::out_of_range("SlabManager::is_empty - Index out of bounds!"));
+
+        return is_slot_empty_unchecked(ind);
+
+        }
+
+    template <class IndexT, unsigned Options, class Storage>
+    inline
+    bool BasicSlabManager<IndexT, Options, Storage>::is_slot_empty_unchecked(Index ind) const noexcept {
+
+        assert(ind < slot_cnt && "SlabManager::is_slot_empty_unchecked - Index out of bounds!");
+
+        return (ind >= touched() || !test_bit(ind));
+
+        }
+
+    template <class IndexT, unsigned Options, class Storage>
+    inline
+    typename BasicSlabManager<IndexT, Options, Storage>::Handle BasicSlabManager<IndexT, Options, Storage>::acquire_handle() {
+
+        static_assert(HAS_GENERATIONS, "SlabManager::acquire_handle - Requires SLAB_GENERATIONS!");
+
+        Handle rv;
+
+        rv.index      = acquire();
+        rv.generation = gen_vec[rv.index];
+
+        return rv;
+
+        }
+
+    template <class IndexT, unsigned Options, class Storage>
+    inline
+    typename BasicSlabManager<IndexT, Options, Storage>::Handle BasicSlabManager<IndexT, Options, Storage>::handle(Index ind) const {
+
+        static_assert(HAS_GENERATIONS, "SlabManager::handle - Requires SLAB_GENERATIONS!");
+
+        if (is_slot_empty(ind)) GEN_SLAB_THROW(std::logic_error("SlabManager::handle - Element not acquired!"));
+
+        Handle rv;
+
+        rv.index      = ind;
+        rv.generation = gen_vec[ind];
+
+        return rv;
+
+        }
+
+    template <class IndexT, unsigned Options, class Storage>
+    inline
+    void BasicSlabManager<IndexT, Options, Storage>::give_back(Handle h) {
+
+        static_assert(HAS_GENERATIONS, "SlabManager::give_back - Requires SLAB_GENERATIONS!");
+
+        if (!is_live(h)) GEN_SLAB_THROW(std::logic_error("SlabManager::give_back - Stale handle!"));
+
+        give_back(h.index);
+
+        }
+
+    template <class IndexT, unsigned Options, class Storage>
+    inline
+    bool BasicSlabManager<IndexT, Options, Storage>::is_live(Handle h) const {
+
+        static_assert(HAS_GENERATIONS, "SlabManager::is_live - Requires SLAB_GENERATIONS!");
+
+        return (h.index < touched() && test_bit(h.index) && gen_vec[h.index] == h.generation);
+
+        }
+
+    template <class IndexT, unsigned Options, class Storage>
+    inline
+    void BasicSlabManager<IndexT, Options, Storage>::clear() {
+        
+        initialize(slot_cnt);
+
+        }
+
+    template <class IndexT, unsigned Options, class Storage>
+    inline
+    size_t BasicSlabManager<IndexT, Options, Storage>::size() const {
+
+        return slot_cnt;
+
+        }
+
+    template <class IndexT, unsigned Options, class Storage>
+    inline
+    size_t BasicSlabManager<IndexT, Options, Storage>::capacity() const {
+
+        return next_vec.capacity();
+
+        }
+
+    template <class IndexT, unsigned Options, class Storage>
+    inline
+    size_t BasicSlabManager<IndexT, Options, Storage>::max_size() {
+
+        // NULL_INDEX is reserved, so the last usable index is one below it:
+        return size_t(NULL_INDEX);
+
+        }
+
+    template <class IndexT, unsigned Options, class Storage>
+    inline
+    void BasicSlabManager<IndexT, Options, Storage>::set_size_limit(size_t n) {
+
+        limit_cnt = (n < max_size()) ? n : max_size();
+
+        }
+
+    template <class IndexT, unsigned Options, class Storage>
+    inline
+    size_t BasicSlabManager<IndexT, Options, Storage>::size_limit() const {
+
+        return limit_cnt;
+
+        }
+
+    template <class IndexT, unsigned Options, class Storage>
+    inline
+    size_t BasicSlabManager<IndexT, Options, Storage>::empty_count() const {
+        
+        return empty_cnt;
+
+        }
+
+    template <class IndexT, unsigned Options, class Storage>
+    inline
+    size_t BasicSlabManager<IndexT, Options, Storage>::filled_count() const {
+        
+        return filled_cnt;
+        
+        }
+
+    template <class IndexT, unsigned Options, class Storage>
+    inline
+    void BasicSlabManager<IndexT, Options, Storage>::resize(size_t newsize) {
+        
+        size_t ss = slot_cnt;
+
+        if (ss == newsize) return;
+
+        if (newsize > ss) { // Upsize
+            
+            if (newsize > limit_cnt) GEN_SLAB_THROW(std::length_error("SlabManager::resize - Size exceeds the size limit!"));
+
+            reserve(newsize);
+
+            // New slots lie past the high-water mark, nothing to link:
+            slot_cnt   = newsize;
+            empty_cnt += (newsize - ss);
+
+            }
+        else { // Downsize
+            
+            newsize = ((newsize > 0) ? newsize : 1l);
+
+            // Scans back from filled_end only, then tightens it:
+            size_t pos = last_filled();
+
+            filled_end = pos + 1;
+            
+            if (pos == size_t(-1)) {
+                
+                initialize(newsize);
+
+                }
+            else {
+
+                size_t cnt = ss - 1 - pos;
+
+                if (pos == ss - 1) return;
+
+                if (cnt <= 4u) return; // Up to 4 trailing empties may remain
+                
+                if (newsize < pos + 1) newsize = pos + 1;
+
+                empty_cnt -= (ss - newsize);
+                slot_cnt   = newsize;
+
+                if (newsize >= touched()) return; // Trimmed only untouched slots
+
+                // Trimmed touched slots are all empty - unlink them, the rest
+                // of the empty list stays as it is:
+                unlink_tail(newsize);
+
+                // The bits left over in the last word are already clear:
+                resize_words(words_for(newsize));
+                if (!NO_FILLED_LIST) prev_vec.resize(newsize);
+                next_vec.resize(newsize);
+
+                }
+
+            }
+        
+        }
+
+    template <class IndexT, unsigned Options, class Storage>
+    inline
+    void BasicSlabManager<IndexT, Options, Storage>::reserve(size_t size) {
+
+        occ_vec.reserve(words_for(size));
+        if (!NO_FILLED_LIST) prev_vec.reserve(size);
+        next_vec.reserve(size);
+
+        if (LOWEST_FIRST) {
+
+            size_t cnt = words_for(size);
+
+            for (size_t k = 0; k < FULL_LEVELS && cnt > 1; k += 1) {
+
+                cnt = words_for(cnt);
+
+                full_lvl[k].reserve(cnt);
+
+                }
+
+            }
+
+        if (HAS_GENERATIONS) gen_vec.reserve(size);
+
+        }
+
+    template <class IndexT, unsigned Options, class Storage>
+    inline
+    void BasicSlabManager<IndexT, Options, Storage>::resize_to_min() {
+
+        resize(1u);
+
+        // Release memory past the trimmed end where the storage allows it:
+        Storage::trim(occ_vec);
+        Storage::trim(prev_vec);
+        Storage::trim(next_vec);
+        Storage::trim(gen_vec);
+        for (auto & lvl : full_lvl) Storage::trim(lvl);
 
         }
 
+    template <class IndexT, unsigned Options, class Storage>
     inline
-    void SlabManager::shrink_to_fit() {
+    void BasicSlabManager<IndexT, Options, Storage>::shrink_to_fit() {
         
-        elem_vec.shrink_to_fit();
+        occ_vec.shrink_to_fit();
+        prev_vec.shrink_to_fit();
+        next_vec.shrink_to_fit();
+        gen_vec.shrink_to_fit();
+        for (auto & lvl : full_lvl) lvl.shrink_to_fit();
+
+        }
+
+    template <class IndexT, unsigned Options, class Storage>
+    template <class Fn>
+    inline
+    void BasicSlabManager<IndexT, Options, Storage>::compact(Fn fn) {
+
+        compact_moves(size_t(-1), fn);
+
+        }
+
+    template <class IndexT, unsigned Options, class Storage>
+    template <class Fn>
+    inline
+    bool BasicSlabManager<IndexT, Options, Storage>::compact_step(size_t budget, Fn fn) {
+
+        static_assert(!NO_FILLED_LIST, "SlabManager::compact_step - Not available with SLAB_NO_FILLED_LIST!");
+
+        return compact_moves(budget, fn);
+
+        }
+
+    template <class IndexT, unsigned Options, class Storage>
+    template <class Fn>
+    inline
+    bool BasicSlabManager<IndexT, Options, Storage>::compact_moves(size_t budget, Fn fn) {
+
+        size_t tt = touched();
+
+        // The lowest hole only moves up and the last filled slot only down:
+        size_t hole = next_clear(0, tt);
+        size_t last = last_filled();
+
+        if (NO_FILLED_LIST) {
+
+            // Holes cannot be unlinked from a singly linked empty list - move
+            // the bits only and rebuild the list once the moves are over
+            // (only compact() gets here, so that is once per call):
+            size_t moved = 0;
+
+            GEN_SLAB_TRY {
+
+                while (last != size_t(-1) && hole < last && moved < budget) {
+
+                    fn(Index(last), Index(hole));
+
+                    set_bit(hole);
+                    clear_bit(last);
+
+                    if (HAS_GENERATIONS) gen_vec[last] += 1;
+
+                    moved += 1;
+
+                    hole = next_clear(hole + 1, tt);
+                    last = prev_set(last);
+
+                    }
+
+                }
+            GEN_SLAB_CATCH_ALL {
+
+                if (moved > 0) relink_empty();
+
+                GEN_SLAB_RETHROW;
+
+                }
+
+            if (moved > 0) relink_empty();
+
+            if (last != size_t(-1) && hole < last) return false;
+
+            }
+
+        while (last != size_t(-1) && hole < last) {
+
+            if (budget == 0) return false;
+
+            fn(Index(last), Index(hole));
+
+            take_empty(Index(hole));
+            give_back(Index(last));
+
+            budget -= 1;
+
+            hole = next_clear(hole + 1, tt);
+            last = prev_set(last);
+
+            }
+
+        resize_to_min();
+
+        return true;
+
+        }
+
+    template <class IndexT, unsigned Options, class Storage>
+    inline
+    typename BasicSlabManager<IndexT, Options, Storage>::FilledIterator BasicSlabManager<IndexT, Options, Storage>::begin() const {
+
+        return filled_slots().begin();
+
+        }
+
+    template <class IndexT, unsigned Options, class Storage>
+    inline
+    typename BasicSlabManager<IndexT, Options, Storage>::FilledIterator BasicSlabManager<IndexT, Options, Storage>::end() const {
+
+        return filled_slots().end();
+
+        }
+
+    template <class IndexT, unsigned Options, class Storage>
+    inline
+    typename BasicSlabManager<IndexT, Options, Storage>::template Range<typename BasicSlabManager<IndexT, Options, Storage>::FilledIterator>
+    BasicSlabManager<IndexT, Options, Storage>::filled_slots() const {
+
+        return filled_range(std::integral_constant<bool, NO_FILLED_LIST>());
+
+        }
+
+    template <class IndexT, unsigned Options, class Storage>
+    inline
+    typename BasicSlabManager<IndexT, Options, Storage>::template Range<typename BasicSlabManager<IndexT, Options, Storage>::ListIterator>
+    BasicSlabManager<IndexT, Options, Storage>::filled_range(std::false_type) const {
+
+        return Range<ListIterator>(ListIterator(this, filled_head), ListIterator(this, NULL_INDEX));
+
+        }
+
+    template <class IndexT, unsigned Options, class Storage>
+    inline
+    typename BasicSlabManager<IndexT, Options, Storage>::template Range<typename BasicSlabManager<IndexT, Options, Storage>::OrderedIterator>
+    BasicSlabManager<IndexT, Options, Storage>::filled_range(std::true_type) const {
+
+        // No filled list (SLAB_NO_FILLED_LIST) - scan the bitmap instead:
+        return filled_slots_ordered();
+
+        }
+
+    template <class IndexT, unsigned Options, class Storage>
+    inline
+    typename BasicSlabManager<IndexT, Options, Storage>::template Range<typename BasicSlabManager<IndexT, Options, Storage>::EmptyIterator>
+    BasicSlabManager<IndexT, Options, Storage>::empty_slots() const {
+
+        Index first = empty_head;
+
+        if (first == NULL_INDEX && touched() < slot_cnt) first = Index(touched());
+
+        return Range<EmptyIterator>(EmptyIterator(this, first), EmptyIterator(this, NULL_INDEX));
+
+        }
+
+    template <class IndexT, unsigned Options, class Storage>
+    inline
+    typename BasicSlabManager<IndexT, Options, Storage>::template Range<typename BasicSlabManager<IndexT, Options, Storage>::OrderedIterator>
+    BasicSlabManager<IndexT, Options, Storage>::filled_slots_ordered() const {
+
+        return Range<OrderedIterator>(OrderedIterator(this, 0), OrderedIterator(this, occ_vec.size()));
+
+        }
+
+    template <class IndexT, unsigned Options, class Storage>
+    template <class Fn>
+    inline
+    void BasicSlabManager<IndexT, Options, Storage>::for_each_filled(Fn fn) const {
+
+        for (size_t w = 0; w < occ_vec.size(); w += 1) {
+
+            Word bits = occ_vec[w];
+
+            while (bits != 0) {
+
+                fn(Index(w * WORD_BITS + detail::ctz64(bits)));
+
+                bits &= (bits - 1);
+
+                }
+
+            }
 
         }
 
     // DEBUG METHODS:
     /*
+    template <class IndexT, unsigned Options, class Storage>
     inline
-    void SlabManager::debug_print() const {
+    void BasicSlabManager<IndexT, Options, Storage>::debug_print() const {
         
         printf("==================================\n");
 
-        for (size_t i = 0; i < elem_vec.size(); i += 1) {
+        for (size_t i = 0; i < prev_vec.size(); i += 1) {
             
-            printf("%d. Element is %s.\n", (int)i, (elem_vec[i].is_empty)?("empty"):("in use"));
+            printf("%d. Element is %s.\n", (int)i, (test_bit(i))?("in use"):("empty"));
 
             }
 
@@ -468,14 +2245,15 @@ namespace gen {
         
         }
 
+    template <class IndexT, unsigned Options, class Storage>
     inline
-    void SlabManager::debug_check_integrity() const {
+    void BasicSlabManager<IndexT, Options, Storage>::debug_check_integrity() const {
         
         size_t counter;
 
         counter = 0;
 
-        for (auto i = empty_head; i != NULL_INDEX; i = elem_vec[i].next) {
+        for (auto i = empty_head; i != NULL_INDEX; i = next_vec[i]) {
             
             counter += 1;
 
@@ -487,7 +2265,7 @@ namespace gen {
 
         counter = 0;
 
-        for (auto i = filled_head; i != NULL_INDEX; i = elem_vec[i].next) {
+        for (auto i = filled_head; i != NULL_INDEX; i = next_vec[i]) {
 
             counter += 1;
 
@@ -497,14 +2275,15 @@ namespace gen {
 
         }
 
+    template <class IndexT, unsigned Options, class Storage>
     inline
-    void SlabManager::debug_lists() const {
+    void BasicSlabManager<IndexT, Options, Storage>::debug_lists() const {
         
         printf("Empty elements [head = %zu].\n", empty_head);
 
-        for (auto i = empty_head; i != NULL_INDEX; i = elem_vec[i].next) {
+        for (auto i = empty_head; i != NULL_INDEX; i = next_vec[i]) {
 
-            printf("%d. prev = %zu; next = %zu \n", i, elem_vec[i].prev, elem_vec[i].next);
+            printf("%d. prev = %zu; next = %zu \n", i, prev_vec[i], next_vec[i]);
 
             }
 
@@ -512,9 +2291,9 @@ namespace gen {
 
         printf("Filled elements [head = %zu].\n", filled_head);
 
-        for (auto i = filled_head; i != NULL_INDEX; i = elem_vec[i].next) {
+        for (auto i = filled_head; i != NULL_INDEX; i = next_vec[i]) {
 
-            printf("%d. prev = %zu; next = %zu \n", i, elem_vec[i].prev, elem_vec[i].next);
+            printf("%d. prev = %zu; next = %zu \n", i, prev_vec[i], next_vec[i]);
 
             }
 
@@ -0,0 +1,198 @@
+#pragma once
+
+#include <vector>
+#include <memory>
+#include <cstddef>
+#include <cstdint>
+#include <utility>
+#include <new>
+#include <stdexcept>
+
+#include "SlabConfig.hpp"
+
+namespace gen {
+
+    // Storage policies for the arrays backing BasicSlabManager and SlabVector.
+    // A policy provides Array<T>, a container of trivially copyable T with the
+    // std::vector subset used by the managers (size, resize, push_back, clear,
+    // reserve, capacity, shrink_to_fit, operator[]); resize() and push_back()
+    // value-initialize new elements. STABLE tells whether elements keep their
+    // address when the array grows, and trim(arr) hands memory past arr.size()
+    // back to the system where that is possible without moving elements.
+
+    /// <summary> Contiguous std::vector storage. Growing may reallocate and move
+    ///        all elements. </summary>
+    ///
+    struct VectorStorage {
+
+        static const bool STABLE = false;
+
+        template <class T>
+        using Array = std::vector<T>;
+
+        template <class T>
+        static void trim(Array<T> &) { }
+
+        };
+
+    /// <summary> Storage split into fixed segments of 2^Shift elements, addressed
+    ///        by index >> Shift. Growing allocates whole segments and never
+    ///        copies or moves existing elements, so their addresses are
+    ///        stable. Segments are kept on clear() and downsizing and only
+    ///        released by shrink_to_fit(). </summary>
+    ///
+    template <unsigned Shift = 12>
+    struct SegmentedStorage {
+
+        static const bool STABLE = true;
+
+        template <class T>
+        class Array {
+
+            public:
+
+                Array()
+                    : cnt(0)
+                    { }
+
+                Array(const Array & other);
+
+                Array(Array && other)
+                    : seg_vec(std::move(other.seg_vec))
+                    , cnt(other.cnt)
+                    { other.seg_vec.clear(); other.cnt = 0; }
+
+                Array & operator=(const Array & other);
+
+                Array & operator=(Array && other) {
+
+                    seg_vec = std::move(other.seg_vec);
+                    cnt     = other.cnt;
+
+                    other.seg_vec.clear();
+                    other.cnt = 0;
+
+                    return *this;
+
+                    }
+
+                T       & operator[](size_t ind)       { return seg_vec[ind >> Shift][ind & MASK]; }
+                const T & operator[](size_t ind) const { return seg_vec[ind >> Shift][ind & MASK]; }
+
+                size_t size() const { return cnt; }
+
+                size_t capacity() const { return seg_vec.size() << Shift; }
+
+                void resize(size_t n);
+
+                void push_back(const T & val);
+
+                void clear() { cnt = 0; }
+
+                void reserve(size_t n);
+
+                void shrink_to_fit();
+
+            private:
+
+                static const size_t SEGMENT = size_t(1) << Shift;
+                static const size_t MASK    = SEGMENT - 1;
+
+                std::vector<std::unique_ptr<T[]>> seg_vec;
+
+                size_t cnt;
+
+            };
+
+        template <class T>
+        static void trim(Array<T> & arr) { arr.shrink_to_fit(); }
+
+        };
+
+    // *** Implementation below: *** //
+
+    template <unsigned Shift>
+    template <class T>
+    inline
+    SegmentedStorage<Shift>::Array<T>::Array(const Array & other)
+        : cnt(0) {
+
+        *this = other;
+
+        }
+
+    template <unsigned Shift>
+    template <class T>
+    inline
+    typename SegmentedStorage<Shift>::template Array<T> & SegmentedStorage<Shift>::Array<T>::operator=(const Array & other) {
+
+        if (this == &other) return *this;
+
+        // Only the segments in use are copied:
+        size_t segs = (other.cnt + MASK) >> Shift;
+
+        std::vector<std::unique_ptr<T[]>> fresh;
+
+        fresh.reserve(segs);
+
+        for (size_t s = 0; s < segs; s += 1) fresh.emplace_back(new T[SEGMENT]);
+
+        for (size_t i = 0; i < other.cnt; i += 1) fresh[i >> Shift][i & MASK] = other[i];
+
+        seg_vec = std::move(fresh);
+        cnt     = other.cnt;
+
+        return *this;
+
+        }
+
+    template <unsigned Shift>
+    template <class T>
+    inline
+    void SegmentedStorage<Shift>::Array<T>::reserve(size_t n) {
+
+        while (capacity() < n) seg_vec.emplace_back(new T[SEGMENT]);
+
+        }
+
+    template <unsigned Shift>
+    template <class T>
+    inline
+    void SegmentedStorage<Shift>::Array<T>::resize(size_t n) {
+
+        reserve(n);
+
+        for (size_t i = cnt; i < n; i += 1) (*this)[i] = T();
+
+        cnt = n;
+
+        }
+
+    template <unsigned Shift>
+    template <class T>
+    inline
+    void SegmentedStorage<Shift>::Array<T>::push_back(const T & val) {
+
+        if (cnt == capacity()) seg_vec.emplace_back(new T[SEGMENT]);
+
+        (*this)[cnt] = val;
+
+        cnt += 1;
+
+        }
+
+    template <unsigned Shift>
+    template <class T>
+    inline
+    void SegmentedStorage<Shift>::Array<T>::shrink_to_fit() {
+
+        size_t keep = (cnt + MASK) >> Shift;
+
+        seg_vec.resize(keep);
+        seg_vec.shrink_to_fit();
+
+        }
+
+    // *** Implementation End *** //
+
+    }
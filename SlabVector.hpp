@@ -0,0 +1,540 @@
+#pragma once
+
+#include "SlabManager.hpp"
+
+#include <new>
+#include <utility>
+#include <iterator>
+#include <stdexcept>
+
+namespace gen {
+
+    /// <summary> Container of T objects addressed by stable slot indices. Slot
+    ///        bookkeeping is done by a BasicSlabManager (Manager); objects live
+    ///        in uninitialized storage, so empty slots never construct or
+    ///        destroy a T. Storage is the storage policy for the objects (the
+    ///        manager's by default). With a STABLE policy such as
+    ///        SegmentedStorage objects never move and pointers to them stay
+    ///        valid; otherwise growing the storage moves the live objects. </summary>
+    ///
+    template <class T, class Manager = SlabManager, class Storage = typename Manager::StoragePolicy>
+    class SlabVector {
+
+        public:
+
+            typedef typename Manager::Index Index;
+            typedef T value_type;
+
+            template <class VecT, class ValueT>
+            class Iterator;
+
+            typedef Iterator<SlabVector, T>             iterator;
+            typedef Iterator<const SlabVector, const T> const_iterator;
+
+        private:
+
+            struct RawSlot {
+
+                alignas(T) unsigned char bytes[sizeof(T)];
+
+                };
+
+            Manager mgr;
+
+            typename Storage::template Array<RawSlot> storage_arr;
+
+            T       * ptr(Index ind)       { return reinterpret_cast<T *>(storage_arr[ind].bytes); }
+            const T * ptr(Index ind) const { return reinterpret_cast<const T *>(storage_arr[ind].bytes); }
+
+            void reserve_storage(size_t n);
+
+            void destroy_all();
+
+        public:
+
+            /// <summary> Forward iterator over live elements in ascending index order.
+            ///        index() returns the slot index of the current element. </summary>
+            ///
+            template <class VecT, class ValueT>
+            class Iterator {
+
+                public:
+
+                    typedef std::forward_iterator_tag iterator_category;
+                    typedef T                         value_type;
+                    typedef std::ptrdiff_t            difference_type;
+                    typedef ValueT *                  pointer;
+                    typedef ValueT &                  reference;
+
+                    Iterator()
+                        : vec(nullptr)
+                        { }
+
+                    ValueT & operator*()  const { return (*vec)[*pos]; }
+                    ValueT * operator->() const { return &(*vec)[*pos]; }
+
+                    Index index() const { return *pos; }
+
+                    Iterator & operator++() { ++pos; return *this; }
+                    Iterator   operator++(int) { Iterator rv = *this; ++pos; return rv; }
+
+                    bool operator==(const Iterator & other) const { return pos == other.pos; }
+                    bool operator!=(const Iterator & other) const { return pos != other.pos; }
+
+                private:
+
+                    friend class SlabVector;
+
+                    Iterator(VecT * vec, typename Manager::OrderedIterator pos)
+                        : vec(vec)
+                        , pos(pos)
+                        { }
+
+                    VecT * vec;
+                    typename Manager::OrderedIterator pos;
+
+                };
+
+            /// <summary> Construct empty. </summary>
+            ///
+            SlabVector();
+
+            /// <summary> Construct with room for n elements. </summary>
+            ///
+            explicit SlabVector(size_t n);
+
+            SlabVector(const SlabVector & other);
+            SlabVector(SlabVector && other);
+
+            SlabVector & operator=(const SlabVector & other);
+            SlabVector & operator=(SlabVector && other);
+
+            /// <summary> Destroys all live elements. </summary>
+            ///
+            ~SlabVector();
+
+            /// <summary> Construct a T in an empty slot and return the slot's index.
+            ///        If the constructor throws, the slot is given back. </summary>
+            ///
+            template <class... Args>
+            Index emplace(Args && ... args);
+
+            /// <summary> Destroy the element in the given slot and give the slot back.
+            ///        Throws std::logic_error if the slot is empty. </summary>
+            ///
+            void erase(Index ind);
+
+            /// <summary> erase() that returns a status code instead of throwing. </summary>
+            ///
+            SlabStatus try_erase(Index ind);
+
+            /// <summary> Unchecked element access. </summary>
+            ///
+            T       & operator[](Index ind);
+            const T & operator[](Index ind) const;
+
+            /// <summary> Checked element access. Throws std::out_of_range if the
+            ///        slot is out of bounds or empty. </summary>
+            ///
+            T       & at(Index ind);
+            const T & at(Index ind) const;
+
+            /// <summary> at() that returns nullptr instead of throwing. </summary>
+            ///
+            T       * try_at(Index ind);
+            const T * try_at(Index ind) const;
+
+            /// <summary> Checks if the slot with the given index holds no element. </summary>
+            ///
+            bool is_slot_empty(Index ind) const;
+
+            /// <summary> Returns the number of live elements. </summary>
+            ///
+            size_t size() const;
+
+            /// <summary> Returns true if there are no live elements. </summary>
+            ///
+            bool empty() const;
+
+            /// <summary> Returns the number of elements storage is allocated for. </summary>
+            ///
+            size_t capacity() const;
+
+            /// <summary> Allocate storage for at least n elements. </summary>
+            ///
+            void reserve(size_t n);
+
+            /// <summary> Destroy all elements and mark all slots as empty. </summary>
+            ///
+            void clear();
+
+            /// <summary> Returns the underlying slot manager. </summary>
+            ///
+            const Manager & manager() const;
+
+            iterator begin();
+            iterator end();
+
+            const_iterator begin() const;
+            const_iterator end() const;
+
+        };
+
+    // *** Implementation below: *** //
+
+    template <class T, class Manager, class Storage>
+    inline
+    SlabVector<T, Manager, Storage>::SlabVector() {
+
+        }
+
+    template <class T, class Manager, class Storage>
+    inline
+    SlabVector<T, Manager, Storage>::SlabVector(size_t n)
+        : mgr(n) {
+
+        reserve_storage(n);
+
+        }
+
+    template <class T, class Manager, class Storage>
+    inline
+    SlabVector<T, Manager, Storage>::SlabVector(const SlabVector & other)
+        : mgr(other.mgr) {
+
+        storage_arr.resize(other.storage_arr.size());
+
+        // Copy live elements, undoing the copies made so far on failure:
+        auto it = other.mgr.filled_slots_ordered().begin();
+        auto ie = other.mgr.filled_slots_ordered().end();
+
+        GEN_SLAB_TRY {
+
+            for (; it != ie; ++it) new (ptr(*it)) T(other[*it]);
+
+            }
+        GEN_SLAB_CATCH_ALL {
+
+            for (auto jt = other.mgr.filled_slots_ordered().begin(); jt != it; ++jt) ptr(*jt)->~T();
+
+            GEN_SLAB_RETHROW;
+
+            }
+
+        }
+
+    template <class T, class Manager, class Storage>
+    inline
+    SlabVector<T, Manager, Storage>::SlabVector(SlabVector && other)
+        : mgr(std::move(other.mgr))
+        , storage_arr(std::move(other.storage_arr)) {
+
+        other.mgr = Manager();
+        other.storage_arr.clear();
+
+        }
+
+    template <class T, class Manager, class Storage>
+    inline
+    SlabVector<T, Manager, Storage> & SlabVector<T, Manager, Storage>::operator=(const SlabVector & other) {
+
+        if (this != &other) {
+
+            SlabVector tmp(other);
+
+            *this = std::move(tmp);
+
+            }
+
+        return *this;
+
+        }
+
+    template <class T, class Manager, class Storage>
+    inline
+    SlabVector<T, Manager, Storage> & SlabVector<T, Manager, Storage>::operator=(SlabVector && other) {
+
+        if (this != &other) {
+
+            destroy_all();
+
+            mgr         = std::move(other.mgr);
+            storage_arr = std::move(other.storage_arr);
+
+            other.mgr = Manager();
+            other.storage_arr.clear();
+
+            }
+
+        return *this;
+
+        }
+
+    template <class T, class Manager, class Storage>
+    inline
+    SlabVector<T, Manager, Storage>::~SlabVector() {
+
+        destroy_all();
+
+        }
+
+    template <class T, class Manager, class Storage>
+    inline
+    void SlabVector<T, Manager, Storage>::destroy_all() {
+
+        if (storage_arr.size() == 0) return;
+
+        mgr.for_each_filled([this](Index ind) { ptr(ind)->~T(); });
+
+        }
+
+    template <class T, class Manager, class Storage>
+    inline
+    void SlabVector<T, Manager, Storage>::reserve_storage(size_t n) {
+
+        size_t cap = storage_arr.size();
+
+        if (n <= cap) return;
+
+        size_t newcap = (cap * 2 > n) ? cap * 2 : n;
+
+        // Stable storage grows in place without moving anything:
+        if (Storage::STABLE) { storage_arr.resize(newcap); return; }
+
+        typename Storage::template Array<RawSlot> fresh;
+
+        fresh.resize(newcap);
+
+        // Relocate live elements in index order, undoing on failure:
+        auto it = mgr.filled_slots_ordered().begin();
+        auto ie = mgr.filled_slots_ordered().end();
+
+        GEN_SLAB_TRY {
+
+            for (; it != ie; ++it) {
+
+                new (fresh[*it].bytes) T(std::move_if_noexcept(*ptr(*it)));
+
+                }
+
+            }
+        GEN_SLAB_CATCH_ALL {
+
+            for (auto jt = mgr.filled_slots_ordered().begin(); jt != it; ++jt) {
+
+                reinterpret_cast<T *>(fresh[*jt].bytes)->~T();
+
+                }
+
+            GEN_SLAB_RETHROW;
+
+            }
+
+        destroy_all();
+
+        storage_arr = std::move(fresh);
+
+        }
+
+    template <class T, class Manager, class Storage>
+    template <class... Args>
+    inline
+    typename SlabVector<T, Manager, Storage>::Index SlabVector<T, Manager, Storage>::emplace(Args && ... args) {
+
+        // The next slot is below the current end, or one past it if the
+        // manager has to grow:
+        reserve_storage((mgr.empty_count() > 0) ? mgr.size() : mgr.size() + 1);
+
+        Index rv = mgr.acquire();
+
+        GEN_SLAB_TRY {
+
+            new (ptr(rv)) T(std::forward<Args>(args)...);
+
+            }
+        GEN_SLAB_CATCH_ALL {
+
+            mgr.give_back(rv);
+
+            GEN_SLAB_RETHROW;
+
+            }
+
+        return rv;
+
+        }
+
+    template <class T, class Manager, class Storage>
+    inline
+    void SlabVector<T, Manager, Storage>::erase(Index ind) {
+
+        if (mgr.is_slot_empty(ind)) GEN_SLAB_THROW(std::logic_error("SlabVector::erase - Element not present!"));
+
+        ptr(ind)->~T();
+
+        mgr.give_back_unchecked(ind);
+
+        }
+
+    template <class T, class Manager, class Storage>
+    inline
+    SlabStatus SlabVector<T, Manager, Storage>::try_erase(Index ind) {
+
+        if (ind >= mgr.size())                return SLAB_OUT_OF_BOUNDS;
+        if (mgr.is_slot_empty_unchecked(ind)) return SLAB_NOT_ACQUIRED;
+
+        ptr(ind)->~T();
+
+        mgr.give_back_unchecked(ind);
+
+        return SLAB_OK;
+
+        }
+
+    template <class T, class Manager, class Storage>
+    inline
+    T & SlabVector<T, Manager, Storage>::operator[](Index ind) {
+
+        return *ptr(ind);
+
+        }
+
+    template <class T, class Manager, class Storage>
+    inline
+    const T & SlabVector<T, Manager, Storage>::operator[](Index ind) const {
+
+        return *ptr(ind);
+
+        }
+
+    template <class T, class Manager, class Storage>
+    inline
+    T & SlabVector<T, Manager, Storage>::at(Index ind) {
+
+        if (mgr.is_slot_empty(ind)) GEN_SLAB_THROW(std::out_of_range("SlabVector::at - Element not present!"));
+
+        return *ptr(ind);
+
+        }
+
+    template <class T, class Manager, class Storage>
+    inline
+    const T & SlabVector<T, Manager, Storage>::at(Index ind) const {
+
+        if (mgr.is_slot_empty(ind)) GEN_SLAB_THROW(std::out_of_range("SlabVector::at - Element not present!"));
+
+        return *ptr(ind);
+
+        }
+
+    template <class T, class Manager, class Storage>
+    inline
+    T * SlabVector<T, Manager, Storage>::try_at(Index ind) {
+
+        return (ind < mgr.size() && !mgr.is_slot_empty_unchecked(ind)) ? ptr(ind) : nullptr;
+
+        }
+
+    template <class T, class Manager, class Storage>
+    inline
+    const T * SlabVector<T, Manager, Storage>::try_at(Index ind) const {
+
+        return (ind < mgr.size() && !mgr.is_slot_empty_unchecked(ind)) ? ptr(ind) : nullptr;
+
+        }
+
+    template <class T, class Manager, class Storage>
+    inline
+    bool SlabVector<T, Manager, Storage>::is_slot_empty(Index ind) const {
+
+        return mgr.is_slot_empty(ind);
+
+        }
+
+    template <class T, class Manager, class Storage>
+    inline
+    size_t SlabVector<T, Manager, Storage>::size() const {
+
+        return mgr.filled_count();
+
+        }
+
+    template <class T, class Manager, class Storage>
+    inline
+    bool SlabVector<T, Manager, Storage>::empty() const {
+
+        return mgr.filled_count() == 0;
+
+        }
+
+    template <class T, class Manager, class Storage>
+    inline
+    size_t SlabVector<T, Manager, Storage>::capacity() const {
+
+        return storage_arr.size();
+
+        }
+
+    template <class T, class Manager, class Storage>
+    inline
+    void SlabVector<T, Manager, Storage>::reserve(size_t n) {
+
+        mgr.reserve(n);
+
+        reserve_storage(n);
+
+        }
+
+    template <class T, class Manager, class Storage>
+    inline
+    void SlabVector<T, Manager, Storage>::clear() {
+
+        destroy_all();
+
+        mgr.clear();
+
+        }
+
+    template <class T, class Manager, class Storage>
+    inline
+    const Manager & SlabVector<T, Manager, Storage>::manager() const {
+
+        return mgr;
+
+        }
+
+    template <class T, class Manager, class Storage>
+    inline
+    typename SlabVector<T, Manager, Storage>::iterator SlabVector<T, Manager, Storage>::begin() {
+
+        return iterator(this, mgr.filled_slots_ordered().begin());
+
+        }
+
+    template <class T, class Manager, class Storage>
+    inline
+    typename SlabVector<T, Manager, Storage>::iterator SlabVector<T, Manager, Storage>::end() {
+
+        return iterator(this, mgr.filled_slots_ordered().end());
+
+        }
+
+    template <class T, class Manager, class Storage>
+    inline
+    typename SlabVector<T, Manager, Storage>::const_iterator SlabVector<T, Manager, Storage>::begin() const {
+
+        return const_iterator(this, mgr.filled_slots_ordered().begin());
+
+        }
+
+    template <class T, class Manager, class Storage>
+    inline
+    typename SlabVector<T, Manager, Storage>::const_iterator SlabVector<T, Manager, Storage>::end() const {
+
+        return const_iterator(this, mgr.filled_slots_ordered().end());
+
+        }
+
+    // *** Implementation End *** //
+
+    }
@@ -0,0 +1,335 @@
+#pragma once
+
+#include <cstddef>
+#include <cstdint>
+#include <cstring>
+#include <new>
+#include <stdexcept>
+
+#include "SlabStorage.hpp"
+
+// Kept apart from SlabStorage.hpp because the POSIX headers declare names
+// such as read, write and link in the global namespace. Include it only
+// where VirtualMemoryStorage is used.
+#if !defined(__unix__) && !defined(__APPLE__)
+#error "SlabVirtualMemory.hpp - VirtualMemoryStorage needs a POSIX system!"
+#endif
+
+#include <sys/mman.h>
+#include <unistd.h>
+
+#define GEN_SLAB_HAS_VIRTUAL_MEMORY 1
+
+namespace gen {
+
+    /// <summary> Options of VirtualMemoryStorage (combine with |). </summary>
+    ///
+    enum VirtualMemoryOptions : unsigned {
+
+        VM_DEFAULT    = 0,
+        VM_HUGE_PAGES = 1u << 0, // 2MB-aligned range advised for transparent huge pages, committed in 2MB steps
+        VM_PREFAULT   = 1u << 1  // Fault in the pages committed by reserve()/resize() right away
+
+        };
+
+    /// <summary> Storage in a virtual address range of ReserveBytes reserved up front
+    ///        with mmap(PROT_NONE) and committed on demand as the array grows.
+    ///        Growth never copies and addresses are stable; trimming hands
+    ///        trailing pages back with madvise(MADV_DONTNEED). Exceeding the
+    ///        reservation throws std::length_error. Flags is a combination of
+    ///        VirtualMemoryOptions. POSIX only. </summary>
+    ///
+    template <size_t ReserveBytes = (size_t(1) << 34), unsigned Flags = VM_DEFAULT>
+    struct VirtualMemoryStorage {
+
+        static const bool STABLE = true;
+
+        template <class T>
+        class Array {
+
+            public:
+
+                Array()
+                    : base(nullptr)
+                    , cnt(0)
+                    , committed(0)
+                    { }
+
+                Array(const Array & other);
+
+                Array(Array && other)
+                    : base(other.base)
+                    , cnt(other.cnt)
+                    , committed(other.committed)
+                    { other.base = nullptr; other.cnt = 0; other.committed = 0; }
+
+                Array & operator=(const Array & other);
+                Array & operator=(Array && other);
+
+                ~Array();
+
+                T       & operator[](size_t ind)       { return base[ind]; }
+                const T & operator[](size_t ind) const { return base[ind]; }
+
+                size_t size() const { return cnt; }
+
+                size_t capacity() const { return committed / sizeof(T); }
+
+                void resize(size_t n);
+
+                void push_back(const T & val);
+
+                void clear() { cnt = 0; }
+
+                void reserve(size_t n);
+
+                void shrink_to_fit();
+
+            private:
+
+                static const size_t HUGE_PAGE = size_t(1) << 21;
+
+                // With huge pages the mapping is rounded up to whole huge pages:
+                static const size_t RESERVE   = ((Flags & VM_HUGE_PAGES) != 0) ? (ReserveBytes + HUGE_PAGE - 1) / HUGE_PAGE * HUGE_PAGE
+                                                                               : ReserveBytes;
+                static const size_t MAX_ELEMS = ReserveBytes / sizeof(T);
+
+                T * base;
+
+                size_t cnt;
+                size_t committed; // Bytes
+
+                static size_t page_size();
+                static size_t granule();
+
+                void map();
+                void commit(size_t bytes, bool prefault);
+
+                static void populate(char * from, size_t len);
+
+            };
+
+        template <class T>
+        static void trim(Array<T> & arr) { arr.shrink_to_fit(); }
+
+        };
+
+    // *** Implementation below: *** //
+
+    template <size_t ReserveBytes, unsigned Flags>
+    template <class T>
+    inline
+    VirtualMemoryStorage<ReserveBytes, Flags>::Array<T>::Array(const Array & other)
+        : Array() {
+
+        *this = other;
+
+        }
+
+    template <size_t ReserveBytes, unsigned Flags>
+    template <class T>
+    inline
+    typename VirtualMemoryStorage<ReserveBytes, Flags>::template Array<T> & VirtualMemoryStorage<ReserveBytes, Flags>::Array<T>::operator=(const Array & other) {
+
+        if (this == &other) return *this;
+
+        reserve(other.cnt);
+
+        if (other.cnt > 0) std::memcpy(static_cast<void *>(base), other.base, other.cnt * sizeof(T));
+
+        cnt = other.cnt;
+
+        return *this;
+
+        }
+
+    template <size_t ReserveBytes, unsigned Flags>
+    template <class T>
+    inline
+    typename VirtualMemoryStorage<ReserveBytes, Flags>::template Array<T> & VirtualMemoryStorage<ReserveBytes, Flags>::Array<T>::operator=(Array && other) {
+
+        if (this == &other) return *this;
+
+        if (base != nullptr) munmap(base, RESERVE);
+
+        base      = other.base;
+        cnt       = other.cnt;
+        committed = other.committed;
+
+        other.base      = nullptr;
+        other.cnt       = 0;
+        other.committed = 0;
+
+        return *this;
+
+        }
+
+    template <size_t ReserveBytes, unsigned Flags>
+    template <class T>
+    inline
+    VirtualMemoryStorage<ReserveBytes, Flags>::Array<T>::~Array() {
+
+        if (base != nullptr) munmap(base, RESERVE);
+
+        }
+
+    template <size_t ReserveBytes, unsigned Flags>
+    template <class T>
+    inline
+    size_t VirtualMemoryStorage<ReserveBytes, Flags>::Array<T>::page_size() {
+
+        static const size_t rv = size_t(sysconf(_SC_PAGESIZE));
+
+        return rv;
+
+        }
+
+    template <size_t ReserveBytes, unsigned Flags>
+    template <class T>
+    inline
+    size_t VirtualMemoryStorage<ReserveBytes, Flags>::Array<T>::granule() {
+
+        return ((Flags & VM_HUGE_PAGES) != 0) ? HUGE_PAGE : page_size();
+
+        }
+
+    template <size_t ReserveBytes, unsigned Flags>
+    template <class T>
+    inline
+    void VirtualMemoryStorage<ReserveBytes, Flags>::Array<T>::map() {
+
+        size_t slack = ((Flags & VM_HUGE_PAGES) != 0) ? HUGE_PAGE : 0;
+
+        void * p = mmap(nullptr, RESERVE + slack, PROT_NONE, MAP_PRIVATE | MAP_ANONYMOUS | MAP_NORESERVE, -1, 0);
+
+        if (p == MAP_FAILED) GEN_SLAB_THROW(std::bad_alloc());
+
+        char * raw = static_cast<char *>(p);
+
+        if ((Flags & VM_HUGE_PAGES) != 0) {
+
+            // Align to a huge page boundary and unmap the slack around it:
+            char * aligned = raw + (HUGE_PAGE - reinterpret_cast<std::uintptr_t>(raw) % HUGE_PAGE) % HUGE_PAGE;
+
+            if (aligned != raw) munmap(raw, size_t(aligned - raw));
+            if (aligned + RESERVE != raw + RESERVE + slack) munmap(aligned + RESERVE, size_t(raw + slack - aligned));
+
+            raw = aligned;
+
+        #if defined(MADV_HUGEPAGE)
+            madvise(raw, RESERVE, MADV_HUGEPAGE);
+        #endif
+
+            }
+
+        base = reinterpret_cast<T *>(raw);
+
+        }
+
+    template <size_t ReserveBytes, unsigned Flags>
+    template <class T>
+    inline
+    void VirtualMemoryStorage<ReserveBytes, Flags>::Array<T>::populate(char * from, size_t len) {
+
+    #if defined(MADV_POPULATE_WRITE)
+        if (madvise(from, len, MADV_POPULATE_WRITE) == 0) return;
+    #endif
+
+        // Older kernels - touch every page (freshly committed pages are zero):
+        size_t page = page_size();
+
+        for (size_t off = 0; off < len; off += page) static_cast<volatile char *>(from)[off] = 0;
+
+        }
+
+    template <size_t ReserveBytes, unsigned Flags>
+    template <class T>
+    inline
+    void VirtualMemoryStorage<ReserveBytes, Flags>::Array<T>::commit(size_t bytes, bool prefault) {
+
+        if (bytes <= committed) return;
+
+        if (bytes > MAX_ELEMS * sizeof(T)) GEN_SLAB_THROW(std::length_error("VirtualMemoryStorage - Reserved address range exhausted!"));
+
+        // Reserve the address range on first use:
+        if (base == nullptr) map();
+
+        // Commit whole pages, at least doubling to keep mprotect() calls rare:
+        size_t gran = granule();
+        size_t want = (committed * 2 > bytes) ? committed * 2 : bytes;
+
+        want = (want + gran - 1) / gran * gran;
+
+        if (want > RESERVE) want = RESERVE;
+
+        char * from = reinterpret_cast<char *>(base) + committed;
+
+        if (mprotect(from, want - committed, PROT_READ | PROT_WRITE) != 0) GEN_SLAB_THROW(std::bad_alloc());
+
+        if (prefault) populate(from, want - committed);
+
+        committed = want;
+
+        }
+
+    template <size_t ReserveBytes, unsigned Flags>
+    template <class T>
+    inline
+    void VirtualMemoryStorage<ReserveBytes, Flags>::Array<T>::reserve(size_t n) {
+
+        if (n > MAX_ELEMS) GEN_SLAB_THROW(std::length_error("VirtualMemoryStorage - Reserved address range exhausted!"));
+
+        commit(n * sizeof(T), (Flags & VM_PREFAULT) != 0);
+
+        }
+
+    template <size_t ReserveBytes, unsigned Flags>
+    template <class T>
+    inline
+    void VirtualMemoryStorage<ReserveBytes, Flags>::Array<T>::resize(size_t n) {
+
+        reserve(n);
+
+        for (size_t i = cnt; i < n; i += 1) base[i] = T();
+
+        cnt = n;
+
+        }
+
+    template <size_t ReserveBytes, unsigned Flags>
+    template <class T>
+    inline
+    void VirtualMemoryStorage<ReserveBytes, Flags>::Array<T>::push_back(const T & val) {
+
+        // Growth on the acquire() path is never prefaulted:
+        if ((cnt + 1) * sizeof(T) > committed) commit((cnt + 1) * sizeof(T), false);
+
+        base[cnt] = val;
+
+        cnt += 1;
+
+        }
+
+    template <size_t ReserveBytes, unsigned Flags>
+    template <class T>
+    inline
+    void VirtualMemoryStorage<ReserveBytes, Flags>::Array<T>::shrink_to_fit() {
+
+        size_t gran = granule();
+        size_t keep = (cnt * sizeof(T) + gran - 1) / gran * gran;
+
+        if (keep >= committed) return;
+
+        // Drop the pages and make the range inaccessible again:
+        char * from = reinterpret_cast<char *>(base) + keep;
+
+        madvise(from, committed - keep, MADV_DONTNEED);
+        mprotect(from, committed - keep, PROT_NONE);
+
+        committed = keep;
+
+        }
+
+    // *** Implementation End *** //
+
+    }
\ No newline at end of file
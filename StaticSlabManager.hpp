@@ -0,0 +1,360 @@
+#pragma once
+
+// constexpr members that modify std::array elements need C++17; older modes
+// fail deep inside the class with an unhelpful "assignment of read-only":
+#if __cplusplus < 201703L && !(defined(_MSVC_LANG) && _MSVC_LANG >= 201703L)
+#error "StaticSlabManager.hpp requires C++17"
+#endif
+
+#include "SlabConfig.hpp"
+
+#include <array>
+#include <cstdint>
+#include <cstddef>
+#include <stdexcept>
+#include <type_traits>
+
+// C++20 lets a constexpr constructor leave members uninitialized and tell
+// constant evaluation (which needs them initialized) apart from run time:
+#if defined(__cpp_constexpr) && __cpp_constexpr >= 201907L && defined(__cpp_lib_is_constant_evaluated)
+#define GEN_SLAB_HAS_CONSTEXPR_DEFAULT_INIT 1
+#endif
+
+namespace gen {
+
+    namespace detail {
+
+        /// <summary> Smallest unsigned type that can index N slots and still
+        ///        spare its largest value for NULL_INDEX. </summary>
+        ///
+        template <size_t N>
+        struct SmallestIndex {
+
+            typedef typename std::conditional<(N <= 0xFFu), std::uint8_t,
+                    typename std::conditional<(N <= 0xFFFFu), std::uint16_t,
+                    typename std::conditional<(N <= 0xFFFFFFFFu), std::uint32_t,
+                                              std::uint64_t>::type>::type>::type type;
+
+            };
+
+        }
+
+    /// <summary> Slab manager with a fixed capacity of N slots held in std::array
+    ///        members, so it never touches the heap and can live in static
+    ///        storage or on the stack. acquire() returns NULL_INDEX instead of
+    ///        growing once all N slots are filled. IndexT defaults to the
+    ///        smallest unsigned type able to index N slots. All methods are
+    ///        constexpr, so slot tables can be built at compile time. Slots
+    ///        are handed out from a lazily bumped mark before the empty list
+    ///        is used, and bitmap words are zeroed as the mark reaches them,
+    ///        so construction at run time and clear() do no per-slot work.
+    ///        The arrays are still zero-filled during constant evaluation,
+    ///        and before C++20, where a constexpr constructor has to
+    ///        initialize every member. Copies read only what was written:
+    ///        the bitmap words below the mark and the links of the empty
+    ///        list. Requires C++17 (mutable std::array
+    ///        access in constant expressions). </summary>
+    ///
+    template <size_t N, class IndexT = typename detail::SmallestIndex<N>::type>
+    class StaticSlabManager {
+
+            static_assert(std::is_integral<IndexT>::value && std::is_unsigned<IndexT>::value,
+                          "StaticSlabManager - IndexT must be an unsigned integer type!");
+
+            static_assert(N > 0, "StaticSlabManager - N must be at least 1!");
+
+            static_assert(N <= size_t(IndexT(-1)), "StaticSlabManager - IndexT is too narrow for N slots!");
+
+        public:
+
+            typedef IndexT Index;
+
+            /// <summary> Returned by acquire() when all slots are filled. </summary>
+            ///
+            static constexpr Index NULL_INDEX = Index(-1);
+
+        private:
+
+            typedef std::uint64_t Word;
+
+            static constexpr size_t WORD_BITS = 64;
+            static constexpr size_t WORD_CNT  = (N + WORD_BITS - 1) / WORD_BITS;
+
+            // Only entries below the mark are ever read - links are written by
+            // give_back() and bitmap words are zeroed when the mark enters them:
+            std::array<Index, N>        next_arr; // Links of the empty list
+            std::array<Word,  WORD_CNT> occ_arr;  // Occupancy bits (bit set = slot filled)
+
+            Index empty_head;
+
+            size_t bump;       // Slots handed out at least once; the rest are empty
+            size_t filled_cnt;
+
+            constexpr void copy_slots(const StaticSlabManager & other);
+
+        public:
+
+            /// <summary> Construct with all N slots empty. </summary>
+            ///
+            constexpr StaticSlabManager();
+
+            constexpr StaticSlabManager(const StaticSlabManager & other);
+            constexpr StaticSlabManager & operator=(const StaticSlabManager & other);
+
+            /// <summary> Acquire a slot (it will be marked as not empty). Returns
+            ///        NULL_INDEX if all N slots are filled. </summary>
+            ///
+            constexpr Index acquire();
+
+            /// <summary> Give a previously acquired slot back. Throws std::logic_error
+            ///        if the slot is empty. </summary>
+            ///
+            constexpr void give_back(Index ind);
+
+            /// <summary> give_back() that returns SLAB_OUT_OF_BOUNDS or SLAB_NOT_ACQUIRED
+            ///        instead of throwing; nothing is changed in that case. </summary>
+            ///
+            constexpr SlabStatus try_give_back(Index ind) noexcept;
+
+            /// <summary> Checks if the slot with the given index is empty. Throws
+            ///        std::out_of_range if ind is not below N. </summary>
+            ///
+            constexpr bool is_slot_empty(Index ind) const;
+
+            /// <summary> Mark all slots as empty. O(1). </summary>
+            ///
+            constexpr void clear();
+
+            /// <summary> Returns the number of slots (N). </summary>
+            ///
+            static constexpr size_t size();
+
+            /// <summary> Returns the number of empty slots. </summary>
+            ///
+            constexpr size_t empty_count() const;
+
+            /// <summary> Returns the number of filled slots. </summary>
+            ///
+            constexpr size_t filled_count() const;
+
+            /// <summary> Call fn(index) for every filled slot in ascending index order.
+            ///        fn may give back the slot it is called with. </summary>
+            ///
+            template <class Fn>
+            constexpr void for_each_filled(Fn fn) const;
+
+        };
+
+    // *** Implementation below: *** //
+
+    template <size_t N, class IndexT>
+    constexpr
+    StaticSlabManager<N, IndexT>::StaticSlabManager()
+    #if defined(GEN_SLAB_HAS_CONSTEXPR_DEFAULT_INIT)
+        : empty_head(NULL_INDEX)
+    #else
+        : next_arr()
+        , occ_arr()
+        , empty_head(NULL_INDEX)
+    #endif
+        , bump(0)
+        , filled_cnt(0) {
+
+    #if defined(GEN_SLAB_HAS_CONSTEXPR_DEFAULT_INIT)
+        // A constant expression must not hold uninitialized values:
+        if (std::is_constant_evaluated()) {
+
+            next_arr = {};
+            occ_arr  = {};
+
+            }
+    #endif
+
+        }
+
+    template <size_t N, class IndexT>
+    constexpr
+    StaticSlabManager<N, IndexT>::StaticSlabManager(const StaticSlabManager & other)
+    #if defined(GEN_SLAB_HAS_CONSTEXPR_DEFAULT_INIT)
+        : empty_head(other.empty_head)
+    #else
+        : next_arr()
+        , occ_arr()
+        , empty_head(other.empty_head)
+    #endif
+        , bump(other.bump)
+        , filled_cnt(other.filled_cnt) {
+
+    #if defined(GEN_SLAB_HAS_CONSTEXPR_DEFAULT_INIT)
+        if (std::is_constant_evaluated()) {
+
+            next_arr = {};
+            occ_arr  = {};
+
+            }
+    #endif
+
+        copy_slots(other);
+
+        }
+
+    template <size_t N, class IndexT>
+    constexpr
+    StaticSlabManager<N, IndexT> & StaticSlabManager<N, IndexT>::operator=(const StaticSlabManager & other) {
+
+        if (this == &other) return *this;
+
+        empty_head = other.empty_head;
+        bump       = other.bump;
+        filled_cnt = other.filled_cnt;
+
+        copy_slots(other);
+
+        return *this;
+
+        }
+
+    template <size_t N, class IndexT>
+    constexpr
+    void StaticSlabManager<N, IndexT>::copy_slots(const StaticSlabManager & other) {
+
+        // Entries the source never wrote may be uninitialized at run time, so
+        // only the bitmap words the mark has entered and the links of slots
+        // on the empty list are copied; nothing else is ever read:
+        for (size_t w = 0; w < (other.bump + WORD_BITS - 1) / WORD_BITS; w += 1) occ_arr[w] = other.occ_arr[w];
+
+        for (Index i = other.empty_head; i != NULL_INDEX; i = other.next_arr[i]) next_arr[i] = other.next_arr[i];
+
+        }
+
+    template <size_t N, class IndexT>
+    constexpr
+    typename StaticSlabManager<N, IndexT>::Index StaticSlabManager<N, IndexT>::acquire() {
+
+        Index rv = NULL_INDEX;
+
+        if (empty_head != NULL_INDEX) {
+
+            rv = empty_head;
+
+            empty_head = next_arr[rv];
+
+            }
+        else if (bump < N) {
+
+            rv = Index(bump);
+
+            if (bump % WORD_BITS == 0) occ_arr[bump / WORD_BITS] = 0;
+
+            bump += 1;
+
+            }
+        else
+            return NULL_INDEX; // Full
+
+        occ_arr[rv / WORD_BITS] |= (Word(1) << (rv % WORD_BITS));
+
+        filled_cnt += 1;
+
+        return rv;
+
+        }
+
+    template <size_t N, class IndexT>
+    constexpr
+    void StaticSlabManager<N, IndexT>::give_back(Index ind) {
+
+        if (is_slot_empty(ind)) GEN_SLAB_THROW(std::logic_error("StaticSlabManager::give_back - Element not acquired!"));
+
+        occ_arr[ind / WORD_BITS] &= ~(Word(1) << (ind % WORD_BITS));
+
+        next_arr[ind] = empty_head;
+        empty_head    = ind;
+
+        filled_cnt -= 1;
+
+        }
+
+    template <size_t N, class IndexT>
+    constexpr
+    SlabStatus StaticSlabManager<N, IndexT>::try_give_back(Index ind) noexcept {
+
+        if (ind >= N) return SLAB_OUT_OF_BOUNDS;
+
+        if (is_slot_empty(ind)) return SLAB_NOT_ACQUIRED;
+
+        give_back(ind);
+
+        return SLAB_OK;
+
+        }
+
+    template <size_t N, class IndexT>
+    constexpr
+    bool StaticSlabManager<N, IndexT>::is_slot_empty(Index ind) const {
+
+        if (ind >= N) GEN_SLAB_THROW(std::out_of_range("StaticSlabManager::is_empty - Index out of bounds!"));
+
+        // Slots at or past the mark are empty and their bitmap word may not be zeroed yet:
+        return ind >= bump || ((occ_arr[ind / WORD_BITS] >> (ind % WORD_BITS)) & 1u) == 0;
+
+        }
+
+    template <size_t N, class IndexT>
+    constexpr
+    void StaticSlabManager<N, IndexT>::clear() {
+
+        // Bitmap words are zeroed again as the mark re-enters them:
+        empty_head = NULL_INDEX;
+        bump       = 0;
+        filled_cnt = 0;
+
+        }
+
+    template <size_t N, class IndexT>
+    constexpr
+    size_t StaticSlabManager<N, IndexT>::size() {
+
+        return N;
+
+        }
+
+    template <size_t N, class IndexT>
+    constexpr
+    size_t StaticSlabManager<N, IndexT>::empty_count() const {
+
+        return N - filled_cnt;
+
+        }
+
+    template <size_t N, class IndexT>
+    constexpr
+    size_t StaticSlabManager<N, IndexT>::filled_count() const {
+
+        return filled_cnt;
+
+        }
+
+    template <size_t N, class IndexT>
+    template <class Fn>
+    constexpr
+    void StaticSlabManager<N, IndexT>::for_each_filled(Fn fn) const {
+
+        for (size_t w = 0; w < (bump + WORD_BITS - 1) / WORD_BITS; w += 1) {
+
+            Word bits = occ_arr[w];
+
+            // Plain bit loop - the bit scan intrinsics are not constexpr:
+            for (size_t b = 0; bits != 0; b += 1, bits >>= 1) {
+
+                if ((bits & 1u) != 0) fn(Index(w * WORD_BITS + b));
+
+                }
+
+            }
+
+        }
+
+    // *** Implementation End *** //
+
+    }
\ No newline at end of file
@@ -0,0 +1,80 @@
+// Microbenchmark of give_back() against give_back_unchecked(): a manager is
+// filled, then all slots are given back in random order and re-acquired,
+// repeatedly. Only the give_back pass is timed. Build with and without
+// -DNDEBUG, since give_back_unchecked() asserts its precondition in debug
+// builds.
+//
+// Build:
+//     c++ -std=c++11 -O2 -DNDEBUG -I.. give_back_unchecked.cpp -o give_back_unchecked
+
+#include "SlabManager.hpp"
+
+#include <algorithm>
+#include <chrono>
+#include <cstdint>
+#include <cstdio>
+#include <random>
+#include <vector>
+
+namespace {
+
+    typedef std::chrono::steady_clock Clock;
+
+    const size_t SLOT_CNT = size_t(1) << 20;
+    const int    ROUNDS   = 20;
+
+    template <class Manager, bool Unchecked>
+    double run() {
+
+        Manager mgr(SLOT_CNT);
+
+        std::vector<typename Manager::Index> inds;
+
+        for (size_t i = 0; i < SLOT_CNT; i += 1) inds.push_back(mgr.acquire());
+
+        std::mt19937 rng(1);
+
+        std::chrono::nanoseconds total(0);
+
+        for (int r = 0; r < ROUNDS; r += 1) {
+
+            std::shuffle(inds.begin(), inds.end(), rng);
+
+            auto start = Clock::now();
+
+            if (Unchecked)
+                for (auto ind : inds) mgr.give_back_unchecked(ind);
+            else
+                for (auto ind : inds) mgr.give_back(ind);
+
+            total += std::chrono::duration_cast<std::chrono::nanoseconds>(Clock::now() - start);
+
+            for (auto & ind : inds) ind = mgr.acquire();
+
+            }
+
+        return double(total.count()) / double(SLOT_CNT * ROUNDS);
+
+        }
+
+    template <class Manager>
+    void compare(const char * name) {
+
+        double checked   = run<Manager, false>();
+        double unchecked = run<Manager, true>();
+
+        std::printf("%-28s give_back %6.2f ns   give_back_unchecked %6.2f ns\n", name, checked, unchecked);
+
+        }
+
+    }
+
+int main() {
+
+    compare<gen::SlabManager>("SlabManager");
+    compare<gen::BasicSlabManager<std::uint32_t>>("BasicSlabManager<uint32_t>");
+    compare<gen::BasicSlabManager<std::uint32_t, gen::SLAB_GENERATIONS>>("  + SLAB_GENERATIONS");
+
+    return 0;
+
+    }
\ No newline at end of file
@@ -0,0 +1,116 @@
+// Benchmark of the VirtualMemoryStorage options: a manager and a parallel
+// array of 64-byte objects are reserved and filled with VM_HUGE_PAGES and
+// VM_PREFAULT on and off. Reported per configuration:
+//
+//     reserve  - time of reserve(), which pre-faults with VM_PREFAULT
+//     acquire  - mean and worst latency of acquire() plus writing the object,
+//                and the number of calls over 1us, while filling for the first
+//                time (page faults land here without VM_PREFAULT)
+//     random   - mean time of a random read over the objects, which is
+//                dominated by TLB misses at this size
+//
+// For hardware TLB miss counts run it under perf, e.g.
+//     perf stat -e dTLB-load-misses,page-faults ./vm_pages
+//
+// Build (POSIX only):
+//     c++ -std=c++11 -O2 -I.. vm_pages.cpp -o vm_pages
+
+#include "SlabManager.hpp"
+#include "SlabVirtualMemory.hpp"
+
+#include <chrono>
+#include <cstdint>
+#include <cstdio>
+#include <random>
+
+namespace {
+
+    typedef std::chrono::steady_clock Clock;
+
+    const size_t OBJ_CNT  = size_t(1) << 22; // 256MB of objects
+    const size_t READ_CNT = size_t(1) << 24;
+
+    struct Object {
+
+        std::uint64_t payload[8];
+
+        explicit Object(std::uint64_t v) { for (auto & p : payload) p = v; }
+
+        };
+
+    double ns_since(Clock::time_point start) {
+
+        return double(std::chrono::duration_cast<std::chrono::nanoseconds>(Clock::now() - start).count());
+
+        }
+
+    template <unsigned Flags>
+    void run(const char * name) {
+
+        typedef gen::VirtualMemoryStorage<(size_t(1) << 30), Flags>             Storage;
+        typedef gen::BasicSlabManager<std::uint32_t, gen::SLAB_DEFAULT, Storage> Manager;
+
+        // Objects live in a parallel array of the same storage policy:
+        Manager mgr;
+
+        typename Storage::template Array<Object> objs;
+
+        auto start = Clock::now();
+
+        mgr.reserve(OBJ_CNT);
+        objs.reserve(OBJ_CNT);
+
+        double reserve_ns = ns_since(start);
+
+        // First acquisitions write to fresh pages:
+        double worst_ns = 0;
+        size_t slow_cnt = 0;
+
+        start = Clock::now();
+
+        for (size_t i = 0; i < OBJ_CNT; i += 1) {
+
+            auto t = Clock::now();
+
+            auto ind = mgr.acquire();
+
+            objs.push_back(Object(ind));
+
+            double ns = ns_since(t);
+
+            if (ns > worst_ns) worst_ns = ns;
+            if (ns > 1000)     slow_cnt += 1;
+
+            }
+
+        double fill_ns = ns_since(start);
+
+        // Random reads over the whole range:
+        std::mt19937 rng(1);
+
+        std::uint64_t sum = 0;
+
+        start = Clock::now();
+
+        for (size_t i = 0; i < READ_CNT; i += 1) sum += objs[rng() % OBJ_CNT].payload[0];
+
+        double read_ns = ns_since(start);
+
+        std::printf("%-22s reserve %8.2f ms   acquire mean %6.1f ns, worst %8.1f us, >1us %7zu   random %5.1f ns  (%llu)\n",
+                    name, reserve_ns / 1e6, fill_ns / double(OBJ_CNT), worst_ns / 1e3, slow_cnt,
+                    read_ns / double(READ_CNT), (unsigned long long)(sum & 1u));
+
+        }
+
+    }
+
+int main() {
+
+    run<gen::VM_DEFAULT>("VM_DEFAULT");
+    run<gen::VM_HUGE_PAGES>("VM_HUGE_PAGES");
+    run<gen::VM_PREFAULT>("VM_PREFAULT");
+    run<gen::VM_HUGE_PAGES | gen::VM_PREFAULT>("VM_HUGE_PAGES|PREFAULT");
+
+    return 0;
+
+    }
\ No newline at end of file
@@ -0,0 +1,96 @@
+// Multi-threaded stress test for ConcurrentSlabManager: 8 threads acquire and
+// give back slots at random while an owner table records which thread holds
+// each slot. A slot handed out twice, or given back by a thread that does
+// not own it, is counted as a duplicate.
+//
+// Build (add -fsanitize=thread to check for data races as well):
+//     c++ -std=c++11 -O2 -pthread -I.. concurrent_stress.cpp -o concurrent_stress
+
+#include "ConcurrentSlabManager.hpp"
+
+#include <atomic>
+#include <cstdio>
+#include <random>
+#include <thread>
+#include <vector>
+
+namespace {
+
+    const unsigned THREAD_CNT = 8;
+    const unsigned OP_CNT     = 200000; // Per thread
+    const size_t   HELD_MAX   = 64;     // Slots held by a thread at once
+
+    }
+
+int main() {
+
+    gen::ConcurrentSlabManager mgr;
+
+    // At most THREAD_CNT * HELD_MAX slots are filled at once, so indices stay below that:
+    std::vector<std::atomic<unsigned>> owner(THREAD_CNT * HELD_MAX);
+
+    for (auto & o : owner) o.store(0);
+
+    std::atomic<size_t> dup_cnt(0);
+    std::atomic<size_t> oob_cnt(0);
+
+    std::vector<std::thread> threads;
+
+    for (unsigned t = 0; t < THREAD_CNT; t += 1) {
+
+        threads.emplace_back([&, t] {
+
+            std::mt19937 rng(t + 1);
+
+            std::vector<gen::ConcurrentSlabManager::Index> held;
+
+            for (unsigned op = 0; op < OP_CNT; op += 1) {
+
+                if (held.empty() || (held.size() < HELD_MAX && rng() % 2 == 0)) {
+
+                    auto ind = mgr.acquire();
+
+                    if (ind >= owner.size()) { oob_cnt += 1; continue; }
+
+                    if (owner[ind].exchange(t + 1) != 0) dup_cnt += 1;
+
+                    held.push_back(ind);
+
+                    }
+                else {
+
+                    size_t k   = rng() % held.size();
+                    auto   ind = held[k];
+
+                    held[k] = held.back();
+                    held.pop_back();
+
+                    if (owner[ind].exchange(0) != t + 1) dup_cnt += 1;
+
+                    mgr.give_back(ind);
+
+                    }
+
+                }
+
+            for (auto ind : held) {
+
+                if (owner[ind].exchange(0) != t + 1) dup_cnt += 1;
+
+                mgr.give_back(ind);
+
+                }
+
+            });
+
+        }
+
+    for (auto & th : threads) th.join();
+
+    size_t filled = mgr.filled_count();
+
+    std::printf("dup=%zu oob=%zu filled=%zu size=%zu\n", dup_cnt.load(), oob_cnt.load(), filled, mgr.size());
+
+    return (dup_cnt == 0 && oob_cnt == 0 && filled == 0) ? 0 : 1;
+
+    }
\ No newline at end of file